@@ -14,6 +14,7 @@
 
 #include <avr/io.h>
 
+#include "prr/prr.h"
 #include "zero/bit_ops.h"
 #include "zero/utility.h"
 
@@ -26,6 +27,19 @@
 #define validate_channel( _channel )            validate_enum( _channel,        ADC_CHANNEL_COUNT )
 #define validate_vref( _vref )                  validate_enum( _vref,           ADC_VREF_COUNT )
 
+/* -- Variables -- */
+
+// Set while the ADC module is acquired from the power reduction register manager
+static bool s_powered = false;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      set_powered( bool )
+ * @brief   Acquires or releases the ADC module's clock, if it is not already in the requested state.
+ */
+static void set_powered( bool powered );
+
 /* -- Procedures -- */
 
 uint16_t adc_get( void )
@@ -37,6 +51,9 @@ uint16_t adc_get( void )
 
 void adc_init( void )
 {
+    // The ADC registers can't be written until the module is powered
+    set_powered( true );
+
     // Set clock prescaler
     // TODO: Calculate this dynamically based on F_CPU???
     _Static_assert( F_CPU == 16000000UL, "ADC module assumes a different CPU frequency!" );
@@ -94,7 +111,17 @@ void adc_set_channel( adc_channel_t chnl )
 
 void adc_set_enabled( bool enabled )
 {
-    assign_bit( ADCSRA, ADEN, enabled );
+    // The ADC must be disabled before its clock is stopped
+    if( enabled )
+    {
+        set_powered( true );
+        set_bit( ADCSRA, ADEN );
+    }
+    else
+    {
+        clear_bit( ADCSRA, ADEN );
+        set_powered( false );
+    }
 
 } /* adc_set_enabled() */
 
@@ -131,3 +158,17 @@ void adc_wait( void )
     while( is_bit_set( ADCSRA, ADSC ) );
 
 } /* adc_wait() */
+
+
+static void set_powered( bool powered )
+{
+    if( powered == s_powered )
+        return;
+
+    if( powered )
+        prr_acquire( PRR_MODULE_ADC );
+    else
+        prr_release( PRR_MODULE_ADC );
+    s_powered = powered;
+
+} /* set_powered() */
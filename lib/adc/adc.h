@@ -81,7 +81,7 @@ uint16_t adc_get( void );
 
 /**
  * @fn      adc_init( void )
- * @brief   Initializes the ADC driver.
+ * @brief   Initializes the ADC driver, and powers up the ADC module.
  * @note    This function must be called before any other functions in this module.
  */
 void adc_init( void );
@@ -113,6 +113,8 @@ void adc_set_channel( adc_channel_t chnl );
 /**
  * @fn      adc_set_enabled( bool )
  * @brief   Enables or disables the power to the ADC.
+ * @note    Disabling the ADC also stops its clock in the power reduction register, and its settings can't be changed
+ *          again until it is re-enabled.
  */
 void adc_set_enabled( bool enabled );
 
@@ -0,0 +1,181 @@
+/**
+ * @file    debounce.c
+ * @brief   Implementation for the debounce library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "zero/bit_ops.h"
+#include "zero/utility.h"
+
+#include "debounce.h"
+
+/* -- Macros -- */
+
+// Ensure configuration is valid
+_Static_assert( DEBOUNCE_SAMPLE_TICKS >= 1 && DEBOUNCE_SAMPLE_TICKS <= 255,
+                "DEBOUNCE_SAMPLE_TICKS must be between 1 and 255!" );
+_Static_assert( DEBOUNCE_HOLD_SAMPLES >= 1 && DEBOUNCE_HOLD_SAMPLES <= 255,
+                "DEBOUNCE_HOLD_SAMPLES must be between 1 and 255!" );
+_Static_assert( DEBOUNCE_LONG_PRESS_STEPS >= 1 && DEBOUNCE_LONG_PRESS_STEPS <= 15,
+                "DEBOUNCE_LONG_PRESS_STEPS must be between 1 and 15!" );
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      hold_equals( debounce_t const*, uint8_t )
+ * @brief   Returns a bitmask of the inputs whose hold counter is equal to `value`.
+ */
+static inline uint8_t hold_equals( debounce_t const* db, uint8_t value );
+
+/**
+ * @fn      hold_increment( debounce_t*, uint8_t )
+ * @brief   Increments the hold counter of each input in `mask`.
+ */
+static inline void hold_increment( debounce_t* db, uint8_t mask );
+
+/**
+ * @fn      take( uint8_t volatile*, uint8_t )
+ * @brief   Returns the bits of `*latch` which are in `mask`, and clears them.
+ */
+static uint8_t take( uint8_t volatile* latch, uint8_t mask );
+
+/* -- Procedures -- */
+
+uint8_t debounce_get_state( debounce_t const* db )
+{
+    return( db->state );
+
+} /* debounce_get_state() */
+
+
+void debounce_init( debounce_t* db, uint8_t state )
+{
+    db->ticks           = DEBOUNCE_SAMPLE_TICKS;
+    db->hold_ticks      = DEBOUNCE_HOLD_SAMPLES;
+    db->count[ 0 ]      = 0xFF;
+    db->count[ 1 ]      = 0xFF;
+    db->hold[ 0 ]       = 0;
+    db->hold[ 1 ]       = 0;
+    db->hold[ 2 ]       = 0;
+    db->hold[ 3 ]       = 0;
+    db->state           = state;
+    db->pressed         = 0;
+    db->released        = 0;
+    db->long_pressed    = 0;
+
+} /* debounce_init() */
+
+
+uint8_t debounce_take_long_pressed( debounce_t* db, uint8_t mask )
+{
+    return( take( & db->long_pressed, mask ) );
+
+} /* debounce_take_long_pressed() */
+
+
+uint8_t debounce_take_pressed( debounce_t* db, uint8_t mask )
+{
+    return( take( & db->pressed, mask ) );
+
+} /* debounce_take_pressed() */
+
+
+uint8_t debounce_take_released( debounce_t* db, uint8_t mask )
+{
+    return( take( & db->released, mask ) );
+
+} /* debounce_take_released() */
+
+
+bool debounce_tick( debounce_t* db )
+{
+    if( --db->ticks != 0 )
+        return( false );
+
+    db->ticks = DEBOUNCE_SAMPLE_TICKS;
+    return( true );
+
+} /* debounce_tick() */
+
+
+void debounce_update( debounce_t* db, uint8_t sample )
+{
+    uint8_t state = db->state;
+
+    // Each input's 2-bit counter is reset to 3 while its sample matches the debounced state, and counts down while it
+    // differs - the inputs which roll over from 0 have differed for DEBOUNCE_SAMPLE_COUNT samples in a row
+    uint8_t changed = state ^ sample;
+    db->count[ 0 ] = ~( db->count[ 0 ] & changed );
+    db->count[ 1 ] = db->count[ 0 ] ^ ( db->count[ 1 ] & changed );
+    changed &= db->count[ 0 ] & db->count[ 1 ];
+
+    state ^= changed;
+    db->state = state;
+    db->pressed |= state & changed;
+    db->released |= ~state & changed;
+
+    // Inputs which are not active always have a hold count of zero
+    db->hold[ 0 ] &= state;
+    db->hold[ 1 ] &= state;
+    db->hold[ 2 ] &= state;
+    db->hold[ 3 ] &= state;
+
+    // Advance the hold counter of each active input, stopping once it registers a long press
+    if( --db->hold_ticks == 0 )
+    {
+        db->hold_ticks = DEBOUNCE_HOLD_SAMPLES;
+
+        uint8_t done = hold_equals( db, DEBOUNCE_LONG_PRESS_STEPS );
+        hold_increment( db, state & ~done );
+        db->long_pressed |= hold_equals( db, DEBOUNCE_LONG_PRESS_STEPS ) & ~done;
+    }
+
+} /* debounce_update() */
+
+
+static inline uint8_t hold_equals( debounce_t const* db, uint8_t value )
+{
+    uint8_t eq = 0xFF;
+    for( uint8_t bit = 0; bit < array_count( db->hold ); bit++ )
+        eq &= ( is_bit_set( value, bit ) ? db->hold[ bit ] : ( uint8_t )~db->hold[ bit ] );
+
+    return( eq );
+
+} /* hold_equals() */
+
+
+static inline void hold_increment( debounce_t* db, uint8_t mask )
+{
+    // Ripple-carry increment, performed on all eight counters in parallel
+    uint8_t carry = mask;
+    for( uint8_t bit = 0; bit < array_count( db->hold ); bit++ )
+    {
+        db->hold[ bit ] ^= carry;
+        carry &= ~db->hold[ bit ];
+    }
+
+} /* hold_increment() */
+
+
+static uint8_t take( uint8_t volatile* latch, uint8_t mask )
+{
+    // Latches may be set from an interrupt handler, so the read and clear must not be interrupted
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+    uint8_t ret = * latch & mask;
+    * latch &= ~ret;
+    if( int_en ) sei();
+
+    return( ret );
+
+} /* take() */
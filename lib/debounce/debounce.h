@@ -0,0 +1,126 @@
+/**
+ * @file    debounce.h
+ * @brief   Header for the debounce library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * This library debounces up to eight digital inputs at once using bit-sliced ("vertical") counters - bit `n` of each
+ * counter byte belongs to input `n`, so every input is updated in parallel by a handful of logical operations. An
+ * input's debounced state only changes after it has been sampled in the new state `DEBOUNCE_SAMPLE_COUNT` times in a
+ * row.
+ *
+ * `debounce_tick()` should be called once per 1 ms system tick (i.e., on each `EVENT_TICK`). When it returns `true`, a
+ * new sample of the inputs should be passed to `debounce_update()`. Press, release, and long press edges are latched
+ * until they are taken by the consumer.
+ */
+
+#if !defined( DEBOUNCE_DEBOUNCE_H )
+#define DEBOUNCE_DEBOUNCE_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* -- Constants -- */
+
+/**
+ * @def     DEBOUNCE_SAMPLE_TICKS
+ * @brief   Number of 1 ms ticks between samples of the inputs.
+ */
+#if !defined( DEBOUNCE_SAMPLE_TICKS )
+    #define DEBOUNCE_SAMPLE_TICKS   5
+#endif
+
+/**
+ * @def     DEBOUNCE_SAMPLE_COUNT
+ * @brief   Number of consecutive samples required to change the debounced state of an input.
+ * @note    This is fixed by the width of the vertical counter.
+ */
+#define DEBOUNCE_SAMPLE_COUNT       4
+
+/**
+ * @def     DEBOUNCE_HOLD_SAMPLES
+ * @brief   Number of samples per step of the long press hold counter.
+ */
+#if !defined( DEBOUNCE_HOLD_SAMPLES )
+    #define DEBOUNCE_HOLD_SAMPLES   16
+#endif
+
+/**
+ * @def     DEBOUNCE_LONG_PRESS_STEPS
+ * @brief   Number of hold counter steps for which an input must be held to register a long press.
+ * @note    With the default settings, a long press is registered after 800 ms (plus or minus one 80 ms step). Must be
+ *          between 1 and 15.
+ */
+#if !defined( DEBOUNCE_LONG_PRESS_STEPS )
+    #define DEBOUNCE_LONG_PRESS_STEPS 10
+#endif
+
+/* -- Types -- */
+
+/**
+ * @struct  debounce_t
+ * @brief   Struct containing the debounce state for a set of up to eight inputs.
+ * @note    The contents of this struct should only be accessed through the procedures below.
+ */
+typedef struct
+{
+    uint8_t             ticks;      /**< Ticks remaining until the next sample.         */
+    uint8_t             hold_ticks; /**< Samples remaining until the next hold step.    */
+    uint8_t             count[ 2 ]; /**< Vertical 2-bit sample counter.                 */
+    uint8_t             hold[ 4 ];  /**< Vertical 4-bit long press hold counter.        */
+    uint8_t volatile    state;      /**< Debounced state of each input.                 */
+    uint8_t volatile    pressed;    /**< Latched press edges.                           */
+    uint8_t volatile    released;   /**< Latched release edges.                         */
+    uint8_t volatile    long_pressed;
+                                    /**^ Latched long press edges.                      */
+} debounce_t;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      debounce_get_state( debounce_t const* )
+ * @brief   Returns the debounced state of every input, with bit `n` set if input `n` is active.
+ */
+uint8_t debounce_get_state( debounce_t const* db );
+
+/**
+ * @fn      debounce_init( debounce_t*, uint8_t )
+ * @brief   Initializes the specified debounce state, with all inputs in the specified initial state.
+ */
+void debounce_init( debounce_t* db, uint8_t state );
+
+/**
+ * @fn      debounce_take_long_pressed( debounce_t*, uint8_t )
+ * @brief   Returns the latched long press edges for the inputs in `mask`, and clears them.
+ */
+uint8_t debounce_take_long_pressed( debounce_t* db, uint8_t mask );
+
+/**
+ * @fn      debounce_take_pressed( debounce_t*, uint8_t )
+ * @brief   Returns the latched press edges for the inputs in `mask`, and clears them.
+ */
+uint8_t debounce_take_pressed( debounce_t* db, uint8_t mask );
+
+/**
+ * @fn      debounce_take_released( debounce_t*, uint8_t )
+ * @brief   Returns the latched release edges for the inputs in `mask`, and clears them.
+ */
+uint8_t debounce_take_released( debounce_t* db, uint8_t mask );
+
+/**
+ * @fn      debounce_tick( debounce_t* )
+ * @brief   Advances the sample timer by one 1 ms tick.
+ * @returns `true` if the inputs should now be sampled and passed to `debounce_update()`.
+ */
+bool debounce_tick( debounce_t* db );
+
+/**
+ * @fn      debounce_update( debounce_t*, uint8_t )
+ * @brief   Updates the specified debounce state with a new sample, with bit `n` set if input `n` is active.
+ */
+void debounce_update( debounce_t* db, uint8_t sample );
+
+#endif /* !defined( DEBOUNCE_DEBOUNCE_H ) */
@@ -0,0 +1,567 @@
+/**
+ * @file    event.c
+ * @brief   Implementation for the system event manager.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2025-08-03
+ */
+
+/* -- Includes -- */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+
+#include "prr/prr.h"
+#include "zero/bit_ops.h"
+#include "zero/register.h"
+#include "zero/utility.h"
+
+#include "event.h"
+
+/* -- Macros -- */
+
+/**
+ * @def     EVENT_VALID
+ * @brief   Returns `true` if the specified event is valid and not `EVENT_NONE`.
+ */
+#define EVENT_VALID( _event )                                                   \
+    ( ( _event ) <= EVENT_MAX && ( _event ) != EVENT_NONE )
+
+// Ensure the deferred work queue is usable with 8-bit free-running indices
+_Static_assert( EVENT_DEFER_SIZE <= 128 && ( EVENT_DEFER_SIZE & ( EVENT_DEFER_SIZE - 1 ) ) == 0,
+                "EVENT_DEFER_SIZE must be a power of two no larger than 128!" );
+_Static_assert( EVENT_DEFER_BATCH >= 1, "EVENT_DEFER_BATCH must be at least 1!" );
+
+// Mask to convert free-running indices into deferred work queue offsets
+#define DEFER_MASK                  ( EVENT_DEFER_SIZE - 1 )
+
+// Helper macros to validate arguments
+#define validate_mode( _mode )      validate_enum( _mode, EVENT_MODE_COUNT )
+#define validate_sleep_req( _req )  validate_enum( _req, EVENT_SLEEP_REQ_COUNT )
+
+// Number of timer counts per millisecond, with the /64 clock prescaler (250 at 16 MHz F_CPU)
+#define COUNTS_PER_MS               ( F_CPU / 64UL / 1000UL )
+
+// Maximum time to sleep before resynchronizing the tick count, so that timer 1 never wraps between synchronizations
+#define MAX_SLEEP_MS                ( 200 )
+_Static_assert( MAX_SLEEP_MS * COUNTS_PER_MS < 0xFF00, "MAX_SLEEP_MS is too long for timer 1!" );
+
+// Number of microseconds per timer count, with the /64 clock prescaler (4 at 16 MHz F_CPU)
+#define US_PER_COUNT                ( 64000000UL / F_CPU )
+_Static_assert( US_PER_COUNT * F_CPU == 64000000UL, "F_CPU must give a whole number of microseconds per count!" );
+
+// Minimum number of counts between programming the compare register and the compare match
+#define MIN_LEAD_COUNTS             ( 8 )
+
+// Time taken to restart the oscillator after power-save or power-down mode, rounded up to whole microseconds
+#define STARTUP_US                  ( ( EVENT_SLEEP_STARTUP_CYCLES * 1000000UL + F_CPU - 1 ) / F_CPU )
+_Static_assert( STARTUP_US <= UINT16_MAX, "EVENT_SLEEP_STARTUP_CYCLES is too long!" );
+
+/* -- Types -- */
+
+/**
+ * @brief   Enumeration of the sleep modes used by the event manager, from the shallowest to the deepest.
+ */
+enum
+{
+    LEVEL_IDLE,                     /**< Idle mode.                                     */
+    LEVEL_ADC,                      /**< ADC noise reduction mode.                      */
+    LEVEL_STANDBY,                  /**< Standby mode.                                  */
+    LEVEL_POWER_SAVE,               /**< Power-save mode.                               */
+    LEVEL_POWER_DOWN,               /**< Power-down mode.                               */
+
+    LEVEL_COUNT,                    /**< Number of sleep modes.                         */
+};
+
+// Bitmask of every sleep mode
+#define ALL_LEVELS                  ( bitmask( LEVEL_COUNT ) - 1 )
+
+/* -- Variables -- */
+
+static event_mode_t         s_mode          = EVENT_MODE_PERIODIC;
+static uint32_t volatile    s_tick          = 0;
+
+// Deferred work queue - the head is only written by interrupt handlers, and the tail is only written by the main loop
+static struct
+{
+    event_work_t            work;
+    void*                   arg;
+}
+s_defer_buf[ EVENT_DEFER_SIZE ];
+static uint8_t volatile     s_defer_head    = 0;
+static uint8_t volatile     s_defer_tail    = 0;
+
+// Sleep mode and wake-up latency (in microseconds) of each level
+static uint8_t const        s_level_modes[ LEVEL_COUNT ] PROGMEM =
+{
+    [ LEVEL_IDLE ]          = SLEEP_MODE_IDLE,
+    [ LEVEL_ADC ]           = SLEEP_MODE_ADC,
+    [ LEVEL_STANDBY ]       = SLEEP_MODE_STANDBY,
+    [ LEVEL_POWER_SAVE ]    = SLEEP_MODE_PWR_SAVE,
+    [ LEVEL_POWER_DOWN ]    = SLEEP_MODE_PWR_DOWN,
+};
+static uint16_t const       s_level_latency[ LEVEL_COUNT ] PROGMEM =
+{
+    [ LEVEL_IDLE ]          = 0,
+    [ LEVEL_ADC ]           = 0,
+    [ LEVEL_STANDBY ]       = 1,
+    [ LEVEL_POWER_SAVE ]    = STARTUP_US,
+    [ LEVEL_POWER_DOWN ]    = STARTUP_US,
+};
+
+// Levels in which each sleep requirement is still serviced
+static uint8_t const        s_req_levels[ EVENT_SLEEP_REQ_COUNT ] PROGMEM =
+{
+    [ EVENT_SLEEP_USART_RX ]        = bitmask( LEVEL_IDLE ),
+    [ EVENT_SLEEP_TIMER ]           = bitmask( LEVEL_IDLE ),
+    [ EVENT_SLEEP_EXT_INT_EDGE ]    = bitmask( LEVEL_IDLE ),
+    [ EVENT_SLEEP_ADC ]             = bitmask2( LEVEL_IDLE, LEVEL_ADC ),
+    [ EVENT_SLEEP_TIMER2_ASYNC ]    = bitmask3( LEVEL_IDLE, LEVEL_ADC, LEVEL_POWER_SAVE ),
+    [ EVENT_SLEEP_PIN_CHANGE ]      = ALL_LEVELS,
+};
+
+// Sleep requirement state
+static uint8_t              s_sleep_counts[ EVENT_SLEEP_REQ_COUNT ];    // number of holders of each requirement
+static uint8_t volatile     s_sleep_levels  = ALL_LEVELS;               // levels which service every requirement
+static uint16_t             s_max_latency   = UINT16_MAX;               // maximum wake-up latency in microseconds
+
+// Tickless mode only
+static uint16_t             s_sync_count    = 0;        // timer 1 count at which s_tick was last incremented
+static uint32_t             s_deadline      = 0;        // tick at which to post EVENT_TICK
+static bool                 s_deadline_set  = false;    // set if s_deadline is valid
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      any_pending( void )
+ * @brief   Returns `true` if any event is pending.
+ */
+static inline bool any_pending( void );
+
+/**
+ * @fn      dispatch( event_handler_t const*, uint8_t, event_t )
+ * @brief   Invokes the handler for the specified event from a handler table in program memory, if it has one.
+ */
+static void dispatch( event_handler_t const* handlers, uint8_t count, event_t event );
+
+/**
+ * @fn      take_pending( register_t, event_t )
+ * @brief   Clears and returns the lowest numbered event pending in the specified register, or `EVENT_NONE`.
+ * @param   reg
+ *          The pending event register to check.
+ * @param   first
+ *          The event corresponding to bit 0 of `reg`.
+ */
+static inline event_t take_pending( register_t reg, event_t first );
+
+/**
+ * @fn      schedule_compare( void )
+ * @brief   Programs the timer 1 compare register for the deadline, or the maximum sleep time if it is further away.
+ * @note    Interrupts must be disabled, and `sync_tick()` must have just been called.
+ */
+static void schedule_compare( void );
+
+/**
+ * @fn      select_sleep_mode( void )
+ * @brief   Returns the deepest sleep mode which services every requirement, and which wakes quickly enough.
+ * @note    Interrupts must be disabled.
+ */
+static uint8_t select_sleep_mode( void );
+
+/**
+ * @fn      sync_tick( void )
+ * @brief   Adds the whole milliseconds elapsed on timer 1 since the last synchronization to the tick count.
+ * @note    Interrupts must be disabled.
+ */
+static void sync_tick( void );
+
+/**
+ * @fn      update_sleep_levels( void )
+ * @brief   Recomputes the set of sleep modes which service every requirement.
+ * @note    Interrupts must be disabled.
+ */
+static void update_sleep_levels( void );
+
+/* -- Procedures -- */
+
+bool event_defer( event_work_t work, void* arg )
+{
+    // The queue has a single producer, so the caller must not be interrupted by another handler which defers work
+    assert( is_bit_clear( SREG, SREG_I ) );
+
+    uint8_t head = s_defer_head;
+    if( ( uint8_t )( head - s_defer_tail ) >= EVENT_DEFER_SIZE )
+        return( false );
+
+    s_defer_buf[ head & DEFER_MASK ].work = work;
+    s_defer_buf[ head & DEFER_MASK ].arg = arg;
+
+    // The entry must be complete before it is published to the main loop
+    compiler_barrier();
+    s_defer_head = head + 1;
+    event_set_pending( EVENT_DEFER );
+
+    return( true );
+
+} /* event_defer() */
+
+
+void event_init( event_mode_t mode )
+{
+    validate_mode( mode );
+
+    // Disable interrupts
+    cli();
+
+    s_mode = mode;
+    s_tick = 0;
+    s_deadline_set = false;
+    s_defer_head = 0;
+    s_defer_tail = 0;
+
+    if( mode == EVENT_MODE_TICKLESS )
+    {
+        // Initialize timer 1 as the primary system clock:
+        // - Waveform generation mode set to normal (free-running)
+        // - Clock prescale set to /64
+        // - Compare register set for the first synchronization
+        prr_acquire( PRR_MODULE_TIMER1 );
+        TCCR1A = 0;
+        TCCR1B = bitmask2( CS10, CS11 );
+        s_sync_count = TCNT1;
+        schedule_compare();
+
+        // Enable OCRA interrupt
+        set_bit( TIMSK1, OCIE1A );
+    }
+    else
+    {
+        // Initialize timer 0 as the primary system clock:
+        // - Waveform generation mode set to CTC
+        // - Clock prescale set to /64
+        // - Compare register set to 249 (the period is OCR0A + 1 counts, so 1 millisecond at 16 MHz F_CPU)
+        prr_acquire( PRR_MODULE_TIMER0 );
+        set_bit( TCCR0A, WGM01 );
+        set_bit( TCCR0B, CS00 );
+        set_bit( TCCR0B, CS01 );
+        OCR0A = COUNTS_PER_MS - 1;
+
+        // Enable OCRA interrupt
+        set_bit( TIMSK0, OCIE0A );
+    }
+
+    // Clear any stale pending flags
+    GPIOR0 = 0;
+    GPIOR1 = 0;
+    GPIOR2 = 0;
+
+    // The tick must keep running in periodic mode (until the application releases this)
+    if( mode == EVENT_MODE_PERIODIC )
+        event_sleep_acquire( EVENT_SLEEP_TIMER );
+
+    // Event handlers run with interrupts enabled
+    sei();
+
+} /* event_init() */
+
+
+void event_run( event_handler_t const* handlers, uint8_t count )
+{
+    while( true )
+    {
+        // Give the application a chance to prepare for sleep once every pending event has been handled
+        if( ! any_pending() )
+            dispatch( handlers, count, EVENT_NONE );
+
+        event_t event = event_wait();
+        if( event == EVENT_DEFER )
+            event_run_deferred();
+        else
+            dispatch( handlers, count, event );
+    }
+
+} /* event_run() */
+
+
+void event_run_deferred( void )
+{
+    uint8_t tail = s_defer_tail;
+    for( uint8_t count = 0; count < EVENT_DEFER_BATCH && tail != s_defer_head; count++ )
+    {
+        // The entry must not be read before the head which published it
+        compiler_barrier();
+        event_work_t work = s_defer_buf[ tail & DEFER_MASK ].work;
+        void* arg = s_defer_buf[ tail & DEFER_MASK ].arg;
+
+        // Free the entry before running the work, so that interrupt handlers can reuse it in the meantime
+        s_defer_tail = ++tail;
+        work( arg );
+    }
+
+    // Come back for the rest once any higher priority events have been handled
+    if( tail != s_defer_head )
+        event_set_pending( EVENT_DEFER );
+
+} /* event_run_deferred() */
+
+
+void event_schedule_tick( uint32_t deadline )
+{
+    // EVENT_TICK is already posted every millisecond in periodic mode
+    if( s_mode != EVENT_MODE_TICKLESS )
+        return;
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+
+    sync_tick();
+    if( ( int32_t )( deadline - s_tick ) <= 0 )
+    {
+        // Deadline has already passed
+        event_set_pending( EVENT_TICK );
+    }
+    else if( ! s_deadline_set || ( int32_t )( deadline - s_deadline ) < 0 )
+    {
+        // Deadline is earlier than any existing deadline
+        s_deadline = deadline;
+        s_deadline_set = true;
+        schedule_compare();
+    }
+
+    if( int_en ) sei();
+
+} /* event_schedule_tick() */
+
+
+void event_sleep_acquire( event_sleep_req_t req )
+{
+    validate_sleep_req( req );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+
+    assert( s_sleep_counts[ req ] != UINT8_MAX );
+    s_sleep_counts[ req ]++;
+    update_sleep_levels();
+
+    if( int_en ) sei();
+
+} /* event_sleep_acquire() */
+
+
+void event_sleep_release( event_sleep_req_t req )
+{
+    validate_sleep_req( req );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+
+    assert( s_sleep_counts[ req ] != 0 );
+    s_sleep_counts[ req ]--;
+    update_sleep_levels();
+
+    if( int_en ) sei();
+
+} /* event_sleep_release() */
+
+
+void event_sleep_set_max_latency( uint16_t us )
+{
+    s_max_latency = us;
+
+} /* event_sleep_set_max_latency() */
+
+
+uint32_t event_tick( void )
+{
+    // Tick is four bytes wide, so it must not be torn by the timer interrupt
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+    if( s_mode == EVENT_MODE_TICKLESS )
+        sync_tick();
+    uint32_t tick = s_tick;
+    if( int_en ) sei();
+
+    return( tick );
+
+} /* event_tick() */
+
+
+uint32_t event_tick_us( void )
+{
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+
+    uint32_t tick;
+    uint16_t counts;
+    if( s_mode == EVENT_MODE_TICKLESS )
+    {
+        // The counter may pass another millisecond boundary after synchronizing, which is accounted for by counts
+        sync_tick();
+        tick = s_tick;
+        counts = TCNT1 - s_sync_count;
+    }
+    else
+    {
+        // If the counter has wrapped but the interrupt hasn't run yet (because interrupts are disabled), the tick count
+        // is one behind the counter
+        tick = s_tick;
+        counts = TCNT0;
+        if( is_bit_set( TIFR0, OCF0A ) && counts < COUNTS_PER_MS - 1 )
+            tick++;
+    }
+
+    if( int_en ) sei();
+
+    return( tick * 1000UL + counts * US_PER_COUNT );
+
+} /* event_tick_us() */
+
+
+event_t event_wait( void )
+{
+    // Interrupts stay disabled from checking the bitmask until the processor is asleep, so an event posted in between
+    // can't be missed - the instruction following sei() always executes before any pending interrupt
+    cli();
+    while( ! any_pending() )
+    {
+        set_sleep_mode( select_sleep_mode() );
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+        cli();
+    }
+
+    // Take the highest priority (lowest numbered) pending event
+    event_t event = take_pending( REGISTER_ADDR( GPIOR0 ), 1 );
+    if( event == EVENT_NONE )
+        event = take_pending( REGISTER_ADDR( GPIOR1 ), 9 );
+    if( event == EVENT_NONE )
+        event = take_pending( REGISTER_ADDR( GPIOR2 ), 17 );
+    sei();
+
+    assert( EVENT_VALID( event ) );
+    return( event );
+
+} /* event_wait() */
+
+
+static inline bool any_pending( void )
+{
+    return( ( GPIOR0 | GPIOR1 | GPIOR2 ) != 0 );
+
+} /* any_pending() */
+
+
+static void dispatch( event_handler_t const* handlers, uint8_t count, event_t event )
+{
+    if( event >= count )
+        return;
+
+    event_handler_t handler = ( event_handler_t )pgm_read_ptr( & handlers[ event ] );
+    if( handler != NULL )
+        handler( event );
+
+} /* dispatch() */
+
+
+static inline event_t take_pending( register_t reg, event_t first )
+{
+    uint8_t pending = * reg;
+    if( pending == 0 )
+        return( EVENT_NONE );
+
+    uint8_t bit = 0;
+    while( is_bit_clear( pending, bit ) )
+        bit++;
+    clear_bit( * reg, bit );
+
+    return( first + bit );
+
+} /* take_pending() */
+
+
+static void schedule_compare( void )
+{
+    uint16_t ms = MAX_SLEEP_MS;
+    if( s_deadline_set && s_deadline - s_tick < MAX_SLEEP_MS )
+        ms = ( uint16_t )( s_deadline - s_tick );
+
+    // Both offsets are relative to the last synchronization, so they can be compared without worrying about the
+    // timer wrapping - if the match would already have been missed, it is pushed back by whole milliseconds
+    uint16_t offset = ms * COUNTS_PER_MS;
+    uint16_t elapsed = TCNT1 - s_sync_count;
+    while( offset < elapsed + MIN_LEAD_COUNTS )
+        offset += COUNTS_PER_MS;
+
+    OCR1A = s_sync_count + offset;
+
+} /* schedule_compare() */
+
+
+static uint8_t select_sleep_mode( void )
+{
+    // In tickless mode, the deadline is posted by timer 1, which only runs in idle mode
+    uint8_t levels = s_sleep_levels;
+    if( s_mode == EVENT_MODE_TICKLESS && s_deadline_set )
+        levels &= bitmask( LEVEL_IDLE );
+
+    // Idle mode services everything, so it is used if no deeper mode is suitable
+    uint8_t level = LEVEL_COUNT - 1;
+    while( level > LEVEL_IDLE &&
+           ( is_bit_clear( levels, level ) || pgm_read_word( & s_level_latency[ level ] ) > s_max_latency ) )
+        level--;
+
+    return( pgm_read_byte( & s_level_modes[ level ] ) );
+
+} /* select_sleep_mode() */
+
+
+static void sync_tick( void )
+{
+    uint16_t elapsed_ms = ( uint16_t )( TCNT1 - s_sync_count ) / COUNTS_PER_MS;
+    s_sync_count += elapsed_ms * COUNTS_PER_MS;
+    s_tick += elapsed_ms;
+
+} /* sync_tick() */
+
+
+static void update_sleep_levels( void )
+{
+    uint8_t levels = ALL_LEVELS;
+    for( event_sleep_req_t req = 0; req < EVENT_SLEEP_REQ_COUNT; req++ )
+        if( s_sleep_counts[ req ] != 0 )
+            levels &= pgm_read_byte( & s_req_levels[ req ] );
+
+    s_sleep_levels = levels;
+
+} /* update_sleep_levels() */
+
+
+ISR( TIMER1_COMPA_vect )
+{
+    sync_tick();
+    if( s_deadline_set && ( int32_t )( s_tick - s_deadline ) >= 0 )
+    {
+        s_deadline_set = false;
+        event_set_pending( EVENT_TICK );
+    }
+    schedule_compare();
+
+} /* ISR( TIMER1_COMPA_vect ) */
+
+
+ISR( TIMER0_COMPA_vect )
+{
+    s_tick++;
+    event_set_pending( EVENT_TICK );
+
+} /* ISR( TIMER0_COMPA_vect ) */
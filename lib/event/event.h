@@ -0,0 +1,301 @@
+/**
+ * @file    event.h
+ * @brief   Header for the system event manager.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2025-08-03
+ *
+ * The event set is defined by the application - `EVENT_NONE` and `EVENT_TICK` are reserved, and applications number
+ * their own events upwards from `EVENT_USER` (e.g., `enum { EVENT_COM_RX = EVENT_USER, ... };`), up to `EVENT_MAX`.
+ * Lower numbered events have higher priority.
+ *
+ * Pending events are stored as flags in the general purpose I/O registers (`GPIOR0` for events 1 through 8, then
+ * `GPIOR1` and `GPIOR2`), so that posting an event from an interrupt handler is a single `sbi` instruction. These
+ * registers are reserved for the event manager and must not be used by any other module.
+ *
+ * In `EVENT_MODE_PERIODIC`, timer 0 interrupts every millisecond to advance the tick count and post `EVENT_TICK`. In
+ * `EVENT_MODE_TICKLESS`, timer 1 instead runs freely and the tick count is computed from the counter whenever it is
+ * read. In that mode `EVENT_TICK` is only posted at the deadline requested by `event_schedule_tick()`, and the
+ * processor otherwise only wakes for other interrupts (plus a brief resynchronization every 200 ms). The `TIMER0_COMPA`
+ * and `TIMER1_COMPA` interrupt handlers are defined by this library, so applications using it must not define them.
+ *
+ * Applications normally hand control to `event_run()`, which sleeps until an event is pending and then dispatches it to
+ * the handler for that event.
+ *
+ * Interrupt handlers may also queue a function and argument with `event_defer()`, to be run later by the main loop. The
+ * queue is lock-free, with the interrupt handlers as its only producer and the main loop as its only consumer. The work
+ * is run in batches of at most `EVENT_DEFER_BATCH` entries, so that a burst of deferred work can't hold off the
+ * higher priority events (i.e., `EVENT_TICK`) for long.
+ *
+ * Each time it waits, the event manager sleeps in the deepest mode which still services every peripheral currently
+ * required with `event_sleep_acquire()`. Timers 0 and 1 only run in idle mode, so idle mode is always used while the
+ * tick is needed - in `EVENT_MODE_PERIODIC`, `EVENT_SLEEP_TIMER` is acquired by `event_init()`, and in
+ * `EVENT_MODE_TICKLESS`, whenever a deadline is scheduled. Otherwise, the tick count does not advance while the
+ * processor is in a deeper mode.
+ */
+
+#if !defined( EVENT_EVENT_H )
+#define EVENT_EVENT_H
+
+/* -- Includes -- */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "zero/bit_ops.h"
+
+/* -- Constants -- */
+
+/**
+ * @def     EVENT_MAX
+ * @brief   Highest event number supported by the event manager (the number of flags in `GPIOR0` through `GPIOR2`).
+ */
+#define EVENT_MAX                   24
+
+/**
+ * @def     EVENT_DEFER_SIZE
+ * @brief   Number of entries in the deferred work queue. Must be a power of two no larger than 128.
+ */
+#if !defined( EVENT_DEFER_SIZE )
+    #define EVENT_DEFER_SIZE        8
+#endif
+
+/**
+ * @def     EVENT_DEFER_BATCH
+ * @brief   Maximum number of deferred work entries run before pending events are checked again.
+ */
+#if !defined( EVENT_DEFER_BATCH )
+    #define EVENT_DEFER_BATCH       4
+#endif
+
+/**
+ * @def     EVENT_SLEEP_STARTUP_CYCLES
+ * @brief   Number of oscillator cycles the processor takes to wake from power-save or power-down mode.
+ * @note    This is set by the `SUT` and `CKSEL` fuses - the default matches the Arduino fuses (a crystal oscillator
+ *          with 16K CK start-up, or about 1 ms at 16 MHz).
+ */
+#if !defined( EVENT_SLEEP_STARTUP_CYCLES )
+    #define EVENT_SLEEP_STARTUP_CYCLES  16384UL
+#endif
+
+/* -- Types -- */
+
+/**
+ * @typedef event_t
+ * @brief   Enumeration of the system events reserved by the event manager.
+ */
+typedef uint8_t event_t;
+enum
+{
+    EVENT_NONE,                     /**< No event occurred.                             */
+    EVENT_TICK,                     /**< 1 millisecond tick, or tickless deadline.      */
+    EVENT_DEFER,                    /**< Deferred work is queued.                       */
+    EVENT_USER,                     /**< First application-defined event.               */
+};
+
+/**
+ * @typedef event_handler_t
+ * @brief   Handler invoked by `event_run()` for an event.
+ */
+typedef void ( * event_handler_t )( event_t event );
+
+/**
+ * @typedef event_work_t
+ * @brief   Function queued by `event_defer()`, to be run by the main loop.
+ */
+typedef void ( * event_work_t )( void* arg );
+
+/**
+ * @typedef event_mode_t
+ * @brief   Enumeration of the supported system clock modes.
+ */
+typedef uint8_t event_mode_t;
+enum
+{
+    EVENT_MODE_PERIODIC,            /**< `EVENT_TICK` is posted every millisecond.      */
+    EVENT_MODE_TICKLESS,            /**< `EVENT_TICK` is posted at requested deadlines. */
+
+    EVENT_MODE_COUNT,               /**< Number of valid modes.                         */
+};
+
+/**
+ * @typedef event_sleep_req_t
+ * @brief   Enumeration of the peripherals which may need to keep running (or to wake the processor) while it sleeps.
+ */
+typedef uint8_t event_sleep_req_t;
+enum
+{
+    EVENT_SLEEP_USART_RX,           /**< USART receiver (idle mode only).               */
+    EVENT_SLEEP_TIMER,              /**< Synchronous timers (idle mode only).           */
+    EVENT_SLEEP_EXT_INT_EDGE,       /**< Edge-triggered INTn (idle mode only).          */
+    EVENT_SLEEP_ADC,                /**< ADC (up to ADC noise reduction mode).          */
+    EVENT_SLEEP_TIMER2_ASYNC,       /**< Asynchronous timer 2 (up to power-save mode).  */
+    EVENT_SLEEP_PIN_CHANGE,         /**< Pin change interrupts (any mode).              */
+
+    EVENT_SLEEP_REQ_COUNT,          /**< Number of valid sleep requirements.            */
+};
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      event_defer( event_work_t, void* )
+ * @brief   Queues the specified function to be called with `arg` by the main loop, and posts `EVENT_DEFER`.
+ * @returns `false` if the queue is full, in which case the work is not queued.
+ * @note    This function should only be called by interrupt handlers (or otherwise with interrupts disabled). Work is
+ *          run in the order it was queued.
+ */
+bool event_defer( event_work_t work, void* arg );
+
+/**
+ * @fn      event_init( event_mode_t )
+ * @brief   Initializes the system event manager, with the system clock in the specified mode.
+ * @note    Global interrupts are enabled by this function.
+ */
+void event_init( event_mode_t mode );
+
+/**
+ * @fn      event_run( event_handler_t const*, uint8_t )
+ * @brief   Waits for events and dispatches each to its handler, forever.
+ * @param   handlers
+ *          Table of handlers in program memory, indexed by event. Entries may be `NULL` for events which need no
+ *          handler. The `EVENT_NONE` entry, if any, is invoked each time every pending event has been handled, just
+ *          before the processor goes to sleep (e.g., to call `event_schedule_tick()`).
+ * @param   count
+ *          The number of entries in `handlers`. Events with no entry are discarded.
+ */
+void event_run( event_handler_t const* handlers, uint8_t count ) __attribute__(( noreturn ));
+
+/**
+ * @fn      event_run_deferred( void )
+ * @brief   Runs up to `EVENT_DEFER_BATCH` entries from the deferred work queue, in the order they were queued.
+ * @note    This is called by `event_run()` for each `EVENT_DEFER`, and only needs to be called directly by applications
+ *          which call `event_wait()` themselves. If work remains afterwards, `EVENT_DEFER` is posted again.
+ */
+void event_run_deferred( void );
+
+/**
+ * @fn      event_schedule_tick( uint32_t )
+ * @brief   Requests that `EVENT_TICK` be posted once the tick count reaches `deadline`.
+ * @note    Only applicable in `EVENT_MODE_TICKLESS` (otherwise, `EVENT_TICK` is posted every millisecond). If an
+ *          earlier deadline is already scheduled, it is kept. Deadlines are cleared once they have been posted.
+ */
+void event_schedule_tick( uint32_t deadline );
+
+/**
+ * @fn      event_sleep_acquire( event_sleep_req_t )
+ * @brief   Notes that the specified peripheral must keep running while the processor sleeps.
+ * @note    Requirements are counted, so each call must be balanced by a call to `event_sleep_release()`. This may be
+ *          called from interrupt handlers.
+ */
+void event_sleep_acquire( event_sleep_req_t req );
+
+/**
+ * @fn      event_sleep_release( event_sleep_req_t )
+ * @brief   Releases a requirement previously acquired with `event_sleep_acquire()`.
+ */
+void event_sleep_release( event_sleep_req_t req );
+
+/**
+ * @fn      event_sleep_set_max_latency( uint16_t )
+ * @brief   Sets the longest time, in microseconds, which the processor may take to wake up (default unlimited).
+ * @note    Power-save and power-down modes stop the oscillator, which takes `EVENT_SLEEP_STARTUP_CYCLES` to restart.
+ *          When that is too long, standby mode is used instead - it keeps the oscillator running and wakes within six
+ *          cycles, at the cost of a little more current.
+ */
+void event_sleep_set_max_latency( uint16_t us );
+
+/**
+ * @fn      event_tick( void )
+ * @brief   Returns the current system tick count.
+ * @note    This may be called from interrupt handlers.
+ */
+uint32_t event_tick( void );
+
+/**
+ * @fn      event_tick_us( void )
+ * @brief   Returns the current system time in microseconds, with the resolution of the system timer (4 us at 16 MHz).
+ * @note    This is consistent with `event_tick()` (i.e., it is the tick count times 1000, plus the time elapsed since
+ *          that tick), and wraps every 2^32 microseconds (about 71.6 minutes) - use `event_elapsed()` to compare
+ *          timestamps. This may be called from interrupt handlers.
+ */
+uint32_t event_tick_us( void );
+
+/**
+ * @fn      event_wait( void )
+ * @brief   Waits for the next system event.
+ * @note    If several events are pending, they are returned in priority order (lowest numbered event first) by
+ *          successive calls.
+ */
+event_t event_wait( void );
+
+/* -- Inline Procedures -- */
+
+/**
+ * @fn      event_elapsed( uint32_t, uint32_t )
+ * @brief   Returns the time elapsed from `start` to `end`, which may be ticks or microseconds.
+ * @note    The result is correct across wraparound of the counter, as long as the interval is shorter than the
+ *          counter's full range.
+ */
+static inline __attribute__(( always_inline )) uint32_t event_elapsed( uint32_t start, uint32_t end )
+{
+    return( end - start );
+
+} /* event_elapsed() */
+
+
+/**
+ * @fn      event_is_pending( event_t )
+ * @brief   Returns `true` if the specified event is pending.
+ * @note    Compiles to a single `sbis` / `sbic` for compile-time constant events in `GPIOR0`.
+ */
+static inline __attribute__(( always_inline )) bool event_is_pending( event_t event )
+{
+    assert( event != EVENT_NONE && event <= EVENT_MAX );
+
+    if( event <= 8 )
+        return( is_bit_set( GPIOR0, event - 1 ) );
+    else if( event <= 16 )
+        return( is_bit_set( GPIOR1, event - 9 ) );
+    else
+        return( is_bit_set( GPIOR2, event - 17 ) );
+
+} /* event_is_pending() */
+
+
+/**
+ * @fn      event_set_pending( event_t )
+ * @brief   Sets the specified event as pending.
+ * @note    This function may be called from interrupt handlers or from the main loop. Posting an event which is already
+ *          pending has no effect, but distinct pending events are never lost. Compiles to a single `sbi` for
+ *          compile-time constant events in `GPIOR0`. Any other event (i.e., a variable event, or an event in `GPIOR1`
+ *          or `GPIOR2`, which are outside of the bit-addressable I/O space) is set with a read-modify-write, with
+ *          interrupts disabled if they are enabled.
+ */
+static inline __attribute__(( always_inline )) void event_set_pending( event_t event )
+{
+    assert( event != EVENT_NONE && event <= EVENT_MAX );
+
+    if( __builtin_constant_p( event ) && event <= 8 )
+    {
+        set_bit( GPIOR0, event - 1 );
+    }
+    else
+    {
+        bool int_en = is_bit_set( SREG, SREG_I );
+        if( int_en ) cli();
+        if( event <= 8 )
+            set_bit( GPIOR0, event - 1 );
+        else if( event <= 16 )
+            set_bit( GPIOR1, event - 9 );
+        else
+            set_bit( GPIOR2, event - 17 );
+        if( int_en ) sei();
+    }
+
+} /* event_set_pending() */
+
+#endif /* !defined( EVENT_EVENT_H ) */
@@ -0,0 +1,368 @@
+/**
+ * @file    gpio-int.c
+ * @brief   Implementation for the GPIO interrupt dispatch module.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "zero/bit_ops.h"
+#include "zero/pinout.h"
+#include "zero/register.h"
+#include "zero/utility.h"
+
+#include "gpio.h"
+#include "gpio-int.h"
+
+/* -- Types -- */
+
+/**
+ * @typedef handler_t
+ * @brief   Struct containing the registration for a single interrupt source.
+ */
+typedef struct
+{
+    gpio_int_callback_t callback;
+    gpio_pin_t          pin;
+    gpio_edge_t         edge;
+} handler_t;
+
+/* -- Macros -- */
+
+// Interrupt source encoding returned by lookup_source()
+// - External interrupts are encoded as SOURCE_EXT_FLAG | INTn
+// - Pin change interrupts are encoded as ( bank << 3 ) | bit
+#define SOURCE_NONE                 ( 0xFF )
+#define SOURCE_EXT_FLAG             ( 0x80 )
+#define SOURCE_PCINT( _bank, _bit ) ( ( uint8_t )( ( ( _bank ) << 3 ) | ( _bit ) ) )
+#define SOURCE_IS_EXT( _src )       ( ( ( _src ) & SOURCE_EXT_FLAG ) != 0 )
+#define SOURCE_EXT_NUM( _src )      ( ( _src ) & 0x07 )
+#define SOURCE_PCINT_BANK( _src )   ( ( _src ) >> 3 )
+#define SOURCE_PCINT_BIT( _src )    ( ( _src ) & 0x07 )
+
+// Helper macros to get the per-bank / per-interrupt control registers
+// (PCMSK0..2 are consecutive in the register map, as are EICRA and EICRB)
+#define PCMSK( _bank )              ( ( & PCMSK0 )[ _bank ] )
+#define EICR( _num )                ( ( & EICRA )[ ( _num ) >> 2 ] )
+#define EICR_SHIFT( _num )          ( ( ( _num ) & 0x03 ) << 1 )
+
+// Interrupt sense control values for each edge
+#define ISC_ANY                     ( 0x01 )
+#define ISC_FALLING                 ( 0x02 )
+#define ISC_RISING                  ( 0x03 )
+
+// Helper macros to define the interrupt handlers
+#define DEFINE_EXT_ISR( _num )                                                  \
+    ISR( INT ## _num ## _vect )                                                 \
+    {                                                                           \
+        dispatch_ext( _num );                                                   \
+    }
+#define DEFINE_PCINT_ISR( _bank )                                               \
+    ISR( PCINT ## _bank ## _vect )                                              \
+    {                                                                           \
+        dispatch_pcint( _bank );                                                \
+    }
+
+// Helper macros to validate arguments
+#define validate_edge( _edge )      validate_enum( _edge, GPIO_EDGE_COUNT )
+
+/* -- Variables -- */
+
+// Registrations for each external interrupt
+static handler_t s_ext_tbl[ _GPIO_EXT_INT_COUNT ];
+
+// Registrations for each pin of each pin change interrupt bank
+static handler_t s_pcint_tbl[ _GPIO_PCINT_BANK_COUNT ][ 8 ];
+
+// Last observed state of each pin change interrupt bank
+static uint8_t s_pcint_snapshot[ _GPIO_PCINT_BANK_COUNT ];
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      dispatch_ext( uint8_t )
+ * @brief   Handles the specified external interrupt.
+ */
+static inline __attribute__(( always_inline )) void dispatch_ext( uint8_t num );
+
+/**
+ * @fn      dispatch_pcint( uint8_t )
+ * @brief   Handles the pin change interrupt for the specified bank.
+ */
+static inline __attribute__(( always_inline )) void dispatch_pcint( uint8_t bank );
+
+/**
+ * @fn      edge_matches( gpio_edge_t, gpio_state_t )
+ * @brief   Returns `true` if a pin which changed to `state` matches the specified edge.
+ */
+static inline bool edge_matches( gpio_edge_t edge, gpio_state_t state );
+
+/**
+ * @fn      lookup_source( gpio_pin_t )
+ * @brief   Returns the encoded interrupt source for the specified pin, or `SOURCE_NONE`.
+ */
+static uint8_t lookup_source( gpio_pin_t pin );
+
+/**
+ * @fn      read_bank( uint8_t )
+ * @brief   Returns the current state of the pins in the specified pin change interrupt bank, in PCINT bit order.
+ */
+static inline __attribute__(( always_inline )) uint8_t read_bank( uint8_t bank );
+
+/* -- Procedures -- */
+
+bool gpio_int_is_supported( gpio_pin_t pin )
+{
+    return( lookup_source( pin ) != SOURCE_NONE );
+
+} /* gpio_int_is_supported() */
+
+
+bool gpio_int_register( gpio_pin_t pin, gpio_edge_t edge, gpio_int_callback_t callback )
+{
+    validate_edge( edge );
+
+    uint8_t src = lookup_source( pin );
+    if( src == SOURCE_NONE )
+        return( false );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+
+    if( SOURCE_IS_EXT( src ) )
+    {
+        uint8_t num = SOURCE_EXT_NUM( src );
+        s_ext_tbl[ num ].callback   = callback;
+        s_ext_tbl[ num ].pin        = pin;
+        s_ext_tbl[ num ].edge       = edge;
+
+        // Changing the sense control may raise a spurious flag, so clear it before enabling the interrupt
+        uint8_t isc = ( edge == GPIO_EDGE_RISING ? ISC_RISING : edge == GPIO_EDGE_FALLING ? ISC_FALLING : ISC_ANY );
+        clear_bit( EIMSK, num );
+        EICR( num ) = ( EICR( num ) & ~( 0x03 << EICR_SHIFT( num ) ) ) | ( isc << EICR_SHIFT( num ) );
+        EIFR = bitmask( num );
+        set_bit( EIMSK, num );
+    }
+    else
+    {
+        uint8_t bank = SOURCE_PCINT_BANK( src );
+        uint8_t mask = bitmask( SOURCE_PCINT_BIT( src ) );
+        s_pcint_tbl[ bank ][ SOURCE_PCINT_BIT( src ) ].callback = callback;
+        s_pcint_tbl[ bank ][ SOURCE_PCINT_BIT( src ) ].pin      = pin;
+        s_pcint_tbl[ bank ][ SOURCE_PCINT_BIT( src ) ].edge     = edge;
+
+        // Only this pin's snapshot bit is refreshed, so changes already pending for other pins in the bank are kept
+        assign_bitmask( s_pcint_snapshot[ bank ], mask, read_bank( bank ) & mask );
+        set_bitmask( PCMSK( bank ), mask );
+
+        // PCIEn / PCIFn are bit n of PCICR / PCIFR
+        if( is_bit_clear( PCICR, bank ) )
+        {
+            PCIFR = bitmask( bank );
+            set_bit( PCICR, bank );
+        }
+    }
+
+    if( int_en ) sei();
+    return( true );
+
+} /* gpio_int_register() */
+
+
+void gpio_int_unregister( gpio_pin_t pin )
+{
+    uint8_t src = lookup_source( pin );
+    if( src == SOURCE_NONE )
+        return;
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+
+    if( SOURCE_IS_EXT( src ) )
+    {
+        uint8_t num = SOURCE_EXT_NUM( src );
+        clear_bit( EIMSK, num );
+        s_ext_tbl[ num ].callback = NULL;
+    }
+    else
+    {
+        uint8_t bank = SOURCE_PCINT_BANK( src );
+        clear_bit( PCMSK( bank ), SOURCE_PCINT_BIT( src ) );
+        if( PCMSK( bank ) == 0 )
+            clear_bit( PCICR, bank );
+        s_pcint_tbl[ bank ][ SOURCE_PCINT_BIT( src ) ].callback = NULL;
+    }
+
+    if( int_en ) sei();
+
+} /* gpio_int_unregister() */
+
+
+static inline __attribute__(( always_inline )) void dispatch_ext( uint8_t num )
+{
+    handler_t const* handler = & s_ext_tbl[ num ];
+    if( ! handler->callback )
+        return;
+
+    // Edge selection was already performed by the hardware
+    gpio_state_t state;
+    if( handler->edge == GPIO_EDGE_RISING )
+        state = GPIO_STATE_HIGH;
+    else if( handler->edge == GPIO_EDGE_FALLING )
+        state = GPIO_STATE_LOW;
+    else
+        state = gpio_get_state( handler->pin );
+
+    handler->callback( handler->pin, state );
+
+} /* dispatch_ext() */
+
+
+static inline __attribute__(( always_inline )) void dispatch_pcint( uint8_t bank )
+{
+    // Find the enabled pins which changed since the last interrupt for this bank
+    uint8_t state = read_bank( bank );
+    uint8_t changed = ( state ^ s_pcint_snapshot[ bank ] ) & PCMSK( bank );
+    s_pcint_snapshot[ bank ] = state;
+
+    handler_t const* handler = s_pcint_tbl[ bank ];
+    for( ; changed != 0; changed >>= 1, state >>= 1, handler++ )
+    {
+        if( is_bit_clear( changed, 0 ) || ! handler->callback )
+            continue;
+
+        gpio_state_t pin_state = ( is_bit_set( state, 0 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
+        if( edge_matches( handler->edge, pin_state ) )
+            handler->callback( handler->pin, pin_state );
+    }
+
+} /* dispatch_pcint() */
+
+
+static inline bool edge_matches( gpio_edge_t edge, gpio_state_t state )
+{
+    return( edge == GPIO_EDGE_BOTH ||
+            ( edge == GPIO_EDGE_RISING && state == GPIO_STATE_HIGH ) ||
+            ( edge == GPIO_EDGE_FALLING && state == GPIO_STATE_LOW ) );
+
+} /* edge_matches() */
+
+
+static uint8_t lookup_source( gpio_pin_t pin )
+{
+    register_t reg = gpio_get_pin_register( pin );
+    uint8_t mask = gpio_get_pin_mask( pin );
+
+    uint8_t bit = 0;
+    while( mask != bitmask( bit ) )
+        bit++;
+
+#if defined( __AVR_ATmega328P__ )
+
+    if( reg == REGISTER_ADDR( PIND ) && ( bit == PIND2 || bit == PIND3 ) )
+        return( SOURCE_EXT_FLAG | ( bit - PIND2 ) );
+    else if( reg == REGISTER_ADDR( PINB ) )
+        return( SOURCE_PCINT( 0, bit ) );
+    else if( reg == REGISTER_ADDR( PINC ) )
+        return( SOURCE_PCINT( 1, bit ) );
+    else if( reg == REGISTER_ADDR( PIND ) )
+        return( SOURCE_PCINT( 2, bit ) );
+
+#elif defined( __AVR_ATmega2560__ )
+
+    if( reg == REGISTER_ADDR( PIND ) && bit <= PIND3 )
+        return( SOURCE_EXT_FLAG | bit );
+    else if( reg == REGISTER_ADDR( PINE ) && bit >= PINE4 )
+        return( SOURCE_EXT_FLAG | bit );
+    else if( reg == REGISTER_ADDR( PINB ) )
+        return( SOURCE_PCINT( 0, bit ) );
+    else if( reg == REGISTER_ADDR( PINE ) && bit == PINE0 )
+        return( SOURCE_PCINT( 1, 0 ) );
+    else if( reg == REGISTER_ADDR( PINJ ) && bit <= PINJ6 )
+        return( SOURCE_PCINT( 1, bit + 1 ) );
+    else if( reg == REGISTER_ADDR( PINK ) )
+        return( SOURCE_PCINT( 2, bit ) );
+
+#endif
+
+    return( SOURCE_NONE );
+
+} /* lookup_source() */
+
+
+static inline __attribute__(( always_inline )) uint8_t read_bank( uint8_t bank )
+{
+#if defined( __AVR_ATmega328P__ )
+
+    switch( bank )
+    {
+    case 0:
+        return( PINB );
+    case 1:
+        return( PINC );
+    default:
+        return( PIND );
+    }
+
+#elif defined( __AVR_ATmega2560__ )
+
+    // Bank 1 is PCINT8 (PE0) followed by PCINT9..15 (PJ0..PJ6)
+    switch( bank )
+    {
+    case 0:
+        return( PINB );
+    case 1:
+        return( ( PINE & bitmask( PINE0 ) ) | ( uint8_t )( PINJ << 1 ) );
+    default:
+        return( PINK );
+    }
+
+#endif
+
+} /* read_bank() */
+
+
+#if( _GPIO_EXT_INT_COUNT > 0 )
+    DEFINE_EXT_ISR( 0 )
+#endif
+#if( _GPIO_EXT_INT_COUNT > 1 )
+    DEFINE_EXT_ISR( 1 )
+#endif
+#if( _GPIO_EXT_INT_COUNT > 2 )
+    DEFINE_EXT_ISR( 2 )
+#endif
+#if( _GPIO_EXT_INT_COUNT > 3 )
+    DEFINE_EXT_ISR( 3 )
+#endif
+#if( _GPIO_EXT_INT_COUNT > 4 )
+    DEFINE_EXT_ISR( 4 )
+#endif
+#if( _GPIO_EXT_INT_COUNT > 5 )
+    DEFINE_EXT_ISR( 5 )
+#endif
+#if( _GPIO_EXT_INT_COUNT > 6 )
+    DEFINE_EXT_ISR( 6 )
+#endif
+#if( _GPIO_EXT_INT_COUNT > 7 )
+    DEFINE_EXT_ISR( 7 )
+#endif
+
+#if( _GPIO_PCINT_BANK_COUNT > 0 )
+    DEFINE_PCINT_ISR( 0 )
+#endif
+#if( _GPIO_PCINT_BANK_COUNT > 1 )
+    DEFINE_PCINT_ISR( 1 )
+#endif
+#if( _GPIO_PCINT_BANK_COUNT > 2 )
+    DEFINE_PCINT_ISR( 2 )
+#endif
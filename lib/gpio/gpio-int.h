@@ -0,0 +1,78 @@
+/**
+ * @file    gpio-int.h
+ * @brief   Header for the GPIO interrupt dispatch module.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * This module dispatches pin change (`PCINTn`) and external (`INTn`) interrupts to per-pin callbacks. Pins which have a
+ * dedicated external interrupt use it, so that edge selection is performed in hardware. All other pins use the pin
+ * change interrupt for their bank, and the changed pins are found by comparing the bank against a cached snapshot.
+ *
+ * The interrupt handlers for every pin change and external interrupt are defined by this module, so applications using
+ * it must not define their own `PCINTn` or `INTn` interrupt handlers.
+ */
+
+#if !defined( GPIO_GPIO_INT_H )
+#define GPIO_GPIO_INT_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio.h"
+
+/* -- Types -- */
+
+/**
+ * @typedef gpio_edge_t
+ * @brief   Enumeration of the pin edges which may trigger an interrupt callback.
+ */
+typedef uint8_t gpio_edge_t;
+enum
+{
+    GPIO_EDGE_RISING,               /**< Pin changed from low to high.                  */
+    GPIO_EDGE_FALLING,              /**< Pin changed from high to low.                  */
+    GPIO_EDGE_BOTH,                 /**< Pin changed in either direction.               */
+
+    GPIO_EDGE_COUNT,                /**< Number of valid edges.                         */
+};
+
+/**
+ * @typedef gpio_int_callback_t
+ * @brief   Callback invoked when a registered edge occurs on a GPIO pin.
+ * @note    The callback runs in interrupt context, and should normally do nothing more than notify the main loop (e.g.,
+ *          by setting an event pending).
+ */
+typedef void ( * gpio_int_callback_t )( gpio_pin_t pin, gpio_state_t state );
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      gpio_int_is_supported( gpio_pin_t )
+ * @brief   Returns `true` if the specified GPIO pin has either a pin change or an external interrupt.
+ */
+bool gpio_int_is_supported( gpio_pin_t pin );
+
+/**
+ * @fn      gpio_int_register( gpio_pin_t, gpio_edge_t, gpio_int_callback_t )
+ * @brief   Enables the interrupt for the specified GPIO pin, and registers a callback for the specified edge.
+ * @param   pin
+ *          The pin to monitor. The pin should already be configured as an input.
+ * @param   edge
+ *          The edge(s) for which `callback` is invoked.
+ * @param   callback
+ *          The callback to invoke, or `NULL` if the interrupt is only being used to wake the processor from sleep.
+ * @returns `true` if the interrupt was enabled, or `false` if the pin does not support interrupts.
+ * @note    Any previously registered callback for the pin is replaced.
+ */
+bool gpio_int_register( gpio_pin_t pin, gpio_edge_t edge, gpio_int_callback_t callback );
+
+/**
+ * @fn      gpio_int_unregister( gpio_pin_t )
+ * @brief   Disables the interrupt for the specified GPIO pin, and removes its callback.
+ */
+void gpio_int_unregister( gpio_pin_t pin );
+
+#endif /* !defined( GPIO_GPIO_INT_H ) */
@@ -10,7 +10,9 @@
 
 #include <assert.h>
 
+#include <avr/interrupt.h>
 #include <avr/io.h>
+#include <avr/pgmspace.h>
 
 #include "zero/bit_ops.h"
 #include "zero/pinout.h"
@@ -22,31 +24,36 @@
 /* -- Macros -- */
 
 // Helper macro for the register table below
+// (only the PINx address is stored - DDRx and PORTx always immediately follow it in the register map, and every port
+//  lies within 256 bytes of the start of the I/O space, so the address fits into a single byte)
 #define DEFINE_REGISTERS( _port, _pin )                                         \
     _DEFINE_REGISTERS( _port, _pin )
 #define _DEFINE_REGISTERS( _port, _pin )                                        \
-    { REGISTER_ADDR( DDR ## _port ),  ( 1 << DD ## _port ## _pin ),             \
-      REGISTER_ADDR( PORT ## _port ), ( 1 << PORT ## _port ## _pin ),           \
-      REGISTER_ADDR( PIN ## _port ),  ( 1 << PIN ## _port ## _pin ) }
+    { ( uint8_t )( _SFR_MEM_ADDR( PIN ## _port ) - __SFR_OFFSET ),              \
+      ( 1 << PIN ## _port ## _pin ) }
+
+// Helper macros to get the registers for a port, given the base returned by lookup_base()
+#define BASE_PIN( _base )           ( ( _base )[ 0 ] )
+#define BASE_DDR( _base )           ( ( _base )[ 1 ] )
+#define BASE_PORT( _base )          ( ( _base )[ 2 ] )
 
 // Helper macros to validate arguments
 #define validate_pin( _pin )        validate_enum( _pin,    GPIO_PIN_COUNT )
 #define validate_dir( _dir )        validate_enum( _dir,    GPIO_DIR_COUNT )
 #define validate_state( _state )    validate_enum( _state,  GPIO_STATE_COUNT )
 
+// Helper macro to get the base register for a port of a GPIO group
+#define GROUP_BASE( _group, _idx )  REGISTER_AT( __SFR_OFFSET + ( _group )->ports[ _idx ].base )
+
 /* -- Constants -- */
 
-// Register lookup table for each GPIO pin
+// Register lookup table for each GPIO pin (stored in flash)
 static struct
 {
-    register_t  ddr_reg;
-    uint8_t     ddr_mask;
-    register_t  out_reg;
-    uint8_t     out_mask;
-    register_t  in_reg;
-    uint8_t     in_mask;
+    uint8_t     base;
+    uint8_t     mask;
 }
-const s_reg_tbl[] =
+const s_reg_tbl[] PROGMEM =
 {
 #if( _GPIO_PIN_COUNT > 0 )
     DEFINE_REGISTERS(   _GPIO_PIN_ARDUINO_D00_PORT,     _GPIO_PIN_ARDUINO_D00_PIN   ),
@@ -263,6 +270,20 @@ const s_reg_tbl[] =
 // Ensure register table has an entry for every defined pin
 _Static_assert( array_count( s_reg_tbl ) == GPIO_PIN_COUNT, "s_reg_tbl must have correct number of entries!" );
 
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      lookup_base( gpio_pin_t )
+ * @brief   Returns the PINx register of the port for the specified pin. DDRx and PORTx immediately follow it.
+ */
+static inline register_t lookup_base( gpio_pin_t pin );
+
+/**
+ * @fn      lookup_mask( gpio_pin_t )
+ * @brief   Returns the bitmask for the specified pin within its port registers.
+ */
+static inline uint8_t lookup_mask( gpio_pin_t pin );
+
 /* -- Procedures -- */
 
 void gpio_get_config( gpio_pin_t pin, gpio_config_t* config )
@@ -280,20 +301,38 @@ gpio_dir_t gpio_get_dir( gpio_pin_t pin )
 {
     validate_pin( pin );
 
-    return( is_bitmask_set( *s_reg_tbl[ pin ].ddr_reg,
-                             s_reg_tbl[ pin ].ddr_mask ) ?
+    register_t base = lookup_base( pin );
+    uint8_t mask = lookup_mask( pin );
+    return( is_bitmask_set( BASE_DDR( base ), mask ) ?
             GPIO_DIR_OUT :
             GPIO_DIR_IN );
 
 } /* gpio_get_dir() */
 
 
+uint8_t gpio_get_pin_mask( gpio_pin_t pin )
+{
+    validate_pin( pin );
+    return( lookup_mask( pin ) );
+
+} /* gpio_get_pin_mask() */
+
+
+register_t gpio_get_pin_register( gpio_pin_t pin )
+{
+    validate_pin( pin );
+    return( lookup_base( pin ) );
+
+} /* gpio_get_pin_register() */
+
+
 bool gpio_get_pullup_enabled( gpio_pin_t pin )
 {
     validate_pin( pin );
 
-    return( ( bool )is_bitmask_set( *s_reg_tbl[ pin ].out_reg,
-                                     s_reg_tbl[ pin ].out_mask ) );
+    register_t base = lookup_base( pin );
+    uint8_t mask = lookup_mask( pin );
+    return( ( bool )is_bitmask_set( BASE_PORT( base ), mask ) );
 
 } /* gpio_get_pullup_enabled() */
 
@@ -302,14 +341,129 @@ gpio_state_t gpio_get_state( gpio_pin_t pin )
 {
     validate_pin( pin );
 
-    return( is_bitmask_set( *s_reg_tbl[ pin ].in_reg,
-                             s_reg_tbl[ pin ].in_mask ) ?
+    register_t base = lookup_base( pin );
+    uint8_t mask = lookup_mask( pin );
+    return( is_bitmask_set( BASE_PIN( base ), mask ) ?
             GPIO_STATE_HIGH :
             GPIO_STATE_LOW );
 
 } /* gpio_get_state() */
 
 
+void gpio_group_init( gpio_group_t* group, gpio_pin_t const* pins, uint8_t pin_count )
+{
+    assert( pin_count <= GPIO_GROUP_MAX_PINS );
+
+    group->pin_count = pin_count;
+    group->port_count = 0;
+
+    for( uint8_t bit = 0; bit < pin_count; bit++ )
+    {
+        validate_pin( pins[ bit ] );
+
+        uint8_t base = pgm_read_byte( & s_reg_tbl[ pins[ bit ] ].base );
+        uint8_t mask = lookup_mask( pins[ bit ] );
+
+        // Find the entry for this pin's port, or allocate a new one
+        uint8_t idx = 0;
+        while( idx < group->port_count && group->ports[ idx ].base != base )
+            idx++;
+        if( idx == group->port_count )
+        {
+            assert( idx < GPIO_GROUP_MAX_PORTS );
+            group->ports[ idx ].base        = base;
+            group->ports[ idx ].mask        = 0;
+            group->ports[ idx ].value_mask  = 0;
+            group->ports[ idx ].shift       = 0;
+            group->ports[ idx ].linear      = true;
+            group->port_count++;
+        }
+
+        // The port can be written with a single shift if every pin on it is the same distance from its value bit
+        uint8_t port_bit = 0;
+        while( mask != bitmask( port_bit ) )
+            port_bit++;
+        int8_t shift = ( int8_t )port_bit - ( int8_t )bit;
+        if( group->ports[ idx ].value_mask == 0 )
+            group->ports[ idx ].shift = shift;
+        else if( group->ports[ idx ].shift != shift )
+            group->ports[ idx ].linear = false;
+
+        group->ports[ idx ].mask |= mask;
+        group->ports[ idx ].value_mask |= bitmask( bit );
+        group->pin_port[ bit ] = idx;
+        group->pin_mask[ bit ] = mask;
+    }
+
+} /* gpio_group_init() */
+
+
+uint8_t gpio_group_read( gpio_group_t const* group )
+{
+    uint8_t value = 0;
+    for( uint8_t idx = 0; idx < group->port_count; idx++ )
+    {
+        uint8_t bits = BASE_PIN( GROUP_BASE( group, idx ) ) & group->ports[ idx ].mask;
+        if( group->ports[ idx ].linear )
+        {
+            int8_t shift = group->ports[ idx ].shift;
+            value |= ( shift >= 0 ? ( uint8_t )( bits >> shift ) : ( uint8_t )( bits << -shift ) );
+        }
+        else
+        {
+            // Shuffle each port bit back into its position in the value
+            for( uint8_t bit = 0; bit < group->pin_count; bit++ )
+                if( group->pin_port[ bit ] == idx && is_bitmask_set( bits, group->pin_mask[ bit ] ) )
+                    set_bit( value, bit );
+        }
+    }
+
+    return( value );
+
+} /* gpio_group_read() */
+
+
+void gpio_group_set_dir( gpio_group_t const* group, gpio_dir_t dir )
+{
+    validate_dir( dir );
+
+    for( uint8_t idx = 0; idx < group->port_count; idx++ )
+        assign_bitmask( BASE_DDR( GROUP_BASE( group, idx ) ), group->ports[ idx ].mask, dir == GPIO_DIR_OUT );
+
+} /* gpio_group_set_dir() */
+
+
+void gpio_group_write( gpio_group_t const* group, uint8_t value )
+{
+    for( uint8_t idx = 0; idx < group->port_count; idx++ )
+    {
+        uint8_t bits;
+        if( group->ports[ idx ].linear )
+        {
+            int8_t shift = group->ports[ idx ].shift;
+            bits = value & group->ports[ idx ].value_mask;
+            bits = ( shift >= 0 ? ( uint8_t )( bits << shift ) : ( uint8_t )( bits >> -shift ) );
+        }
+        else
+        {
+            // Shuffle each value bit into its position on the port
+            bits = 0;
+            for( uint8_t bit = 0; bit < group->pin_count; bit++ )
+                if( group->pin_port[ bit ] == idx && is_bit_set( value, bit ) )
+                    bits |= group->pin_mask[ bit ];
+        }
+
+        register_t base = GROUP_BASE( group, idx );
+        uint8_t mask = group->ports[ idx ].mask;
+        if( mask == 0xFF )
+            BASE_PORT( base ) = bits;
+        else
+            BASE_PORT( base ) = ( BASE_PORT( base ) & ~mask ) | bits;
+    }
+
+} /* gpio_group_write() */
+
+
 void gpio_set_config( gpio_pin_t pin, gpio_config_t const* config )
 {
     gpio_set_dir( pin, config->dir );
@@ -326,9 +480,9 @@ void gpio_set_dir( gpio_pin_t pin, gpio_dir_t dir )
     validate_pin( pin );
     validate_dir( dir );
 
-    assign_bitmask( *s_reg_tbl[ pin ].ddr_reg,
-                     s_reg_tbl[ pin ].ddr_mask,
-                     dir == GPIO_DIR_OUT );
+    register_t base = lookup_base( pin );
+    uint8_t mask = lookup_mask( pin );
+    assign_bitmask( BASE_DDR( base ), mask, dir == GPIO_DIR_OUT );
 
 } /* gpio_set_dir() */
 
@@ -337,9 +491,9 @@ void gpio_set_pullup_enabled( gpio_pin_t pin, bool enabled )
 {
     validate_pin( pin );
 
-    assign_bitmask( *s_reg_tbl[ pin ].out_reg,
-                     s_reg_tbl[ pin ].out_mask,
-                     enabled );
+    register_t base = lookup_base( pin );
+    uint8_t mask = lookup_mask( pin );
+    assign_bitmask( BASE_PORT( base ), mask, enabled );
 
 } /* gpio_set_pullup_enabled() */
 
@@ -349,18 +503,52 @@ void gpio_set_state( gpio_pin_t pin, gpio_state_t state )
     validate_pin( pin );
     validate_state( state );
 
-    assign_bitmask( *s_reg_tbl[ pin ].out_reg,
-                     s_reg_tbl[ pin ].out_mask,
-                     state == GPIO_STATE_HIGH );
+    register_t base = lookup_base( pin );
+    uint8_t mask = lookup_mask( pin );
+    assign_bitmask( BASE_PORT( base ), mask, state == GPIO_STATE_HIGH );
 
 } /* gpio_set_state() */
 
 
+void gpio_set_state_atomic( gpio_pin_t pin, gpio_state_t state )
+{
+    validate_pin( pin );
+    validate_state( state );
+
+    register_t base = lookup_base( pin );
+    uint8_t mask = lookup_mask( pin );
+
+    // The port address is only known at runtime, so this is always a read-modify-write
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+    assign_bitmask( BASE_PORT( base ), mask, state == GPIO_STATE_HIGH );
+    if( int_en ) sei();
+
+} /* gpio_set_state_atomic() */
+
+
 void gpio_toggle_state( gpio_pin_t pin )
 {
     validate_pin( pin );
 
-    toggle_bitmask( *s_reg_tbl[ pin ].out_reg,
-                     s_reg_tbl[ pin ].out_mask );
+    register_t base = lookup_base( pin );
+    uint8_t mask = lookup_mask( pin );
+
+    // Writing a 1 to PINx toggles PORTx in hardware, without a read-modify-write
+    BASE_PIN( base ) = mask;
 
 } /* gpio_toggle_state() */
+
+
+static inline register_t lookup_base( gpio_pin_t pin )
+{
+    return( REGISTER_AT( __SFR_OFFSET + pgm_read_byte( & s_reg_tbl[ pin ].base ) ) );
+
+} /* lookup_base() */
+
+
+static inline uint8_t lookup_mask( gpio_pin_t pin )
+{
+    return( pgm_read_byte( & s_reg_tbl[ pin ].mask ) );
+
+} /* lookup_mask() */
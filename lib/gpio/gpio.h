@@ -14,7 +14,53 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "zero/bit_ops.h"
 #include "zero/pinout.h"
+#include "zero/register.h"
+
+/* -- Constants -- */
+
+/**
+ * @def     GPIO_GROUP_MAX_PINS
+ * @brief   Maximum number of pins in a `gpio_group_t`.
+ */
+#define GPIO_GROUP_MAX_PINS         8
+
+/**
+ * @def     GPIO_GROUP_MAX_PORTS
+ * @brief   Maximum number of distinct physical ports which the pins of a `gpio_group_t` may be spread across.
+ */
+#define GPIO_GROUP_MAX_PORTS        4
+
+/* -- Macros -- */
+
+// Helper macros to resolve a compile-time constant pin to its port registers, used by the inline procedures below
+// - The resolved value packs the PINx address (as an offset from the start of I/O space) into the high byte, and the
+//   pin's bitmask into the low byte. DDRx and PORTx always immediately follow PINx.
+#define _GPIO_CONST_CASE( _n )                                                  \
+    __GPIO_CONST_CASE( GPIO_PIN_ARDUINO_D ## _n,                                \
+                       _GPIO_PIN_ARDUINO_D ## _n ## _PORT,                      \
+                       _GPIO_PIN_ARDUINO_D ## _n ## _PIN )
+#define __GPIO_CONST_CASE( _pin, _port, _bit )                                  \
+    ___GPIO_CONST_CASE( _pin, _port, _bit )
+#define ___GPIO_CONST_CASE( _pin, _port, _bit )                                 \
+    case _pin:                                                                  \
+        return( ( uint16_t )( ( _SFR_MEM_ADDR( PIN ## _port ) - __SFR_OFFSET ) << 8 ) | bitmask( _bit ) )
+#define _GPIO_CONST_PIN( _reg )                                                 \
+    ( REGISTER_AT( __SFR_OFFSET + ( ( _reg ) >> 8 ) )[ 0 ] )
+#define _GPIO_CONST_DDR( _reg )                                                 \
+    ( REGISTER_AT( __SFR_OFFSET + ( ( _reg ) >> 8 ) )[ 1 ] )
+#define _GPIO_CONST_PORT( _reg )                                                \
+    ( REGISTER_AT( __SFR_OFFSET + ( ( _reg ) >> 8 ) )[ 2 ] )
+#define _GPIO_CONST_MASK( _reg )                                                \
+    ( ( uint8_t )( ( _reg ) & 0xFF ) )
+
+// Returns true if the PORTx register for the resolved value can be reached by the `sbi` / `cbi` instructions
+#define _GPIO_CONST_PORT_IS_BIT_ADDRESSABLE( _reg )                             \
+    ( ( ( _reg ) >> 8 ) + 2 < 0x20 )
 
 /* -- Types -- */
 
@@ -287,6 +333,30 @@ typedef struct
     };
 } gpio_config_t;
 
+/**
+ * @struct  gpio_group_t
+ * @brief   Struct representing an ordered group of GPIO pins, which are written together as a single value.
+ * @note    The contents of this struct are computed by `gpio_group_init()` and should not be modified directly.
+ */
+typedef struct
+{
+    uint8_t             pin_count;  /**< Number of pins in the group.                   */
+    uint8_t             port_count; /**< Number of physical ports used by the group.    */
+    uint8_t             pin_port[ GPIO_GROUP_MAX_PINS ];
+                                    /**^ Index into `ports` for each value bit.         */
+    uint8_t             pin_mask[ GPIO_GROUP_MAX_PINS ];
+                                    /**^ Port register bitmask for each value bit.      */
+    struct
+    {
+        uint8_t         base;       /**< PINx address, offset from the I/O space.       */
+        uint8_t         mask;       /**< Bitmask of all group pins on the port.         */
+        uint8_t         value_mask; /**< Bitmask of the value bits mapped to the port.  */
+        int8_t          shift;      /**< Left shift from value bits to port bits.       */
+        bool            linear;     /**< Set if `shift` maps every value bit.           */
+    }                   ports[ GPIO_GROUP_MAX_PORTS ];
+                                    /**^ Register information for each physical port.  */
+} gpio_group_t;
+
 /* -- Procedure Prototypes -- */
 
 /**
@@ -301,6 +371,18 @@ void gpio_get_config( gpio_pin_t pin, gpio_config_t* config );
  */
 gpio_dir_t gpio_get_dir( gpio_pin_t pin );
 
+/**
+ * @fn      gpio_get_pin_mask( gpio_pin_t )
+ * @brief   Returns the bitmask for the specified GPIO pin within its port registers.
+ */
+uint8_t gpio_get_pin_mask( gpio_pin_t pin );
+
+/**
+ * @fn      gpio_get_pin_register( gpio_pin_t )
+ * @brief   Returns the PINx register of the port for the specified GPIO pin. DDRx and PORTx immediately follow it.
+ */
+register_t gpio_get_pin_register( gpio_pin_t pin );
+
 /**
  * @fn      gpio_get_pullup_enabled( gpio_pin_t )
  * @brief   Gets the enablement of the pull-up resistor for the specified GPIO pin.
@@ -314,6 +396,35 @@ bool gpio_get_pullup_enabled( gpio_pin_t pin );
  */
 gpio_state_t gpio_get_state( gpio_pin_t pin );
 
+/**
+ * @fn      gpio_group_init( gpio_group_t*, gpio_pin_t const*, uint8_t )
+ * @brief   Initializes a GPIO group for the specified pins. Bit `n` of each value written to the group is assigned to
+ *          `pins[ n ]`.
+ * @note    This only precomputes the register access plan - it does not configure the pins themselves.
+ */
+void gpio_group_init( gpio_group_t* group, gpio_pin_t const* pins, uint8_t pin_count );
+
+/**
+ * @fn      gpio_group_read( gpio_group_t const* )
+ * @brief   Returns the state of every pin in the specified GPIO group, with bit `n` set if `pins[ n ]` is high.
+ * @note    Each physical port is read exactly once.
+ */
+uint8_t gpio_group_read( gpio_group_t const* group );
+
+/**
+ * @fn      gpio_group_set_dir( gpio_group_t const*, gpio_dir_t )
+ * @brief   Sets the I/O direction (in or out) of every pin in the specified GPIO group.
+ */
+void gpio_group_set_dir( gpio_group_t const* group, gpio_dir_t dir );
+
+/**
+ * @fn      gpio_group_write( gpio_group_t const*, uint8_t )
+ * @brief   Sets the state of every pin in the specified GPIO group from the bits of `value`.
+ * @note    Each physical port is accessed exactly once. Ports which are wholly owned by the group are written with a
+ *          single store, and all other ports with a (non-atomic) read-modify-write.
+ */
+void gpio_group_write( gpio_group_t const* group, uint8_t value );
+
 /**
  * @fn      gpio_set_config( gpio_pin_t, gpio_config_t const* )
  * @brief   Sets the configuration of the specified GPIO pin.
@@ -336,13 +447,370 @@ void gpio_set_pullup_enabled( gpio_pin_t pin, bool enabled );
 /**
  * @fn      gpio_set_state( gpio_pin_t, gpio_state_t )
  * @brief   Sets the state (low or high) of the specified GPIO pin.
+ * @note    This is a read-modify-write of the PORTx register, and is not safe against an interrupt handler which modifies
+ *          another pin on the same port. Use `gpio_set_state_atomic()` in that case.
  */
 void gpio_set_state( gpio_pin_t pin, gpio_state_t state );
 
+/**
+ * @fn      gpio_set_state_atomic( gpio_pin_t, gpio_state_t )
+ * @brief   Sets the state (low or high) of the specified GPIO pin, with interrupts disabled for the read-modify-write of
+ *          the PORTx register.
+ */
+void gpio_set_state_atomic( gpio_pin_t pin, gpio_state_t state );
+
 /**
  * @fn      gpio_toggle_state( gpio_pin_t )
  * @brief   Toggles the state of the specified GPIO pin.
+ * @note    Uses the hardware toggle (writing a 1 to the PINx register), so this is always atomic.
  */
 void gpio_toggle_state( gpio_pin_t pin );
 
+/* -- Inline Procedures -- */
+
+/**
+ * @fn      _gpio_const_lookup( gpio_pin_t )
+ * @brief   Resolves the registers for the specified pin. Only intended to be called with a compile-time constant pin,
+ *          in which case the entire switch is folded away.
+ */
+static inline __attribute__(( always_inline )) uint16_t _gpio_const_lookup( gpio_pin_t pin )
+{
+    switch( pin )
+    {
+#if( _GPIO_PIN_COUNT > 0 )
+    _GPIO_CONST_CASE( 00 );
+#endif
+#if( _GPIO_PIN_COUNT > 1 )
+    _GPIO_CONST_CASE( 01 );
+#endif
+#if( _GPIO_PIN_COUNT > 2 )
+    _GPIO_CONST_CASE( 02 );
+#endif
+#if( _GPIO_PIN_COUNT > 3 )
+    _GPIO_CONST_CASE( 03 );
+#endif
+#if( _GPIO_PIN_COUNT > 4 )
+    _GPIO_CONST_CASE( 04 );
+#endif
+#if( _GPIO_PIN_COUNT > 5 )
+    _GPIO_CONST_CASE( 05 );
+#endif
+#if( _GPIO_PIN_COUNT > 6 )
+    _GPIO_CONST_CASE( 06 );
+#endif
+#if( _GPIO_PIN_COUNT > 7 )
+    _GPIO_CONST_CASE( 07 );
+#endif
+#if( _GPIO_PIN_COUNT > 8 )
+    _GPIO_CONST_CASE( 08 );
+#endif
+#if( _GPIO_PIN_COUNT > 9 )
+    _GPIO_CONST_CASE( 09 );
+#endif
+#if( _GPIO_PIN_COUNT > 10 )
+    _GPIO_CONST_CASE( 10 );
+#endif
+#if( _GPIO_PIN_COUNT > 11 )
+    _GPIO_CONST_CASE( 11 );
+#endif
+#if( _GPIO_PIN_COUNT > 12 )
+    _GPIO_CONST_CASE( 12 );
+#endif
+#if( _GPIO_PIN_COUNT > 13 )
+    _GPIO_CONST_CASE( 13 );
+#endif
+#if( _GPIO_PIN_COUNT > 14 )
+    _GPIO_CONST_CASE( 14 );
+#endif
+#if( _GPIO_PIN_COUNT > 15 )
+    _GPIO_CONST_CASE( 15 );
+#endif
+#if( _GPIO_PIN_COUNT > 16 )
+    _GPIO_CONST_CASE( 16 );
+#endif
+#if( _GPIO_PIN_COUNT > 17 )
+    _GPIO_CONST_CASE( 17 );
+#endif
+#if( _GPIO_PIN_COUNT > 18 )
+    _GPIO_CONST_CASE( 18 );
+#endif
+#if( _GPIO_PIN_COUNT > 19 )
+    _GPIO_CONST_CASE( 19 );
+#endif
+#if( _GPIO_PIN_COUNT > 20 )
+    _GPIO_CONST_CASE( 20 );
+#endif
+#if( _GPIO_PIN_COUNT > 21 )
+    _GPIO_CONST_CASE( 21 );
+#endif
+#if( _GPIO_PIN_COUNT > 22 )
+    _GPIO_CONST_CASE( 22 );
+#endif
+#if( _GPIO_PIN_COUNT > 23 )
+    _GPIO_CONST_CASE( 23 );
+#endif
+#if( _GPIO_PIN_COUNT > 24 )
+    _GPIO_CONST_CASE( 24 );
+#endif
+#if( _GPIO_PIN_COUNT > 25 )
+    _GPIO_CONST_CASE( 25 );
+#endif
+#if( _GPIO_PIN_COUNT > 26 )
+    _GPIO_CONST_CASE( 26 );
+#endif
+#if( _GPIO_PIN_COUNT > 27 )
+    _GPIO_CONST_CASE( 27 );
+#endif
+#if( _GPIO_PIN_COUNT > 28 )
+    _GPIO_CONST_CASE( 28 );
+#endif
+#if( _GPIO_PIN_COUNT > 29 )
+    _GPIO_CONST_CASE( 29 );
+#endif
+#if( _GPIO_PIN_COUNT > 30 )
+    _GPIO_CONST_CASE( 30 );
+#endif
+#if( _GPIO_PIN_COUNT > 31 )
+    _GPIO_CONST_CASE( 31 );
+#endif
+#if( _GPIO_PIN_COUNT > 32 )
+    _GPIO_CONST_CASE( 32 );
+#endif
+#if( _GPIO_PIN_COUNT > 33 )
+    _GPIO_CONST_CASE( 33 );
+#endif
+#if( _GPIO_PIN_COUNT > 34 )
+    _GPIO_CONST_CASE( 34 );
+#endif
+#if( _GPIO_PIN_COUNT > 35 )
+    _GPIO_CONST_CASE( 35 );
+#endif
+#if( _GPIO_PIN_COUNT > 36 )
+    _GPIO_CONST_CASE( 36 );
+#endif
+#if( _GPIO_PIN_COUNT > 37 )
+    _GPIO_CONST_CASE( 37 );
+#endif
+#if( _GPIO_PIN_COUNT > 38 )
+    _GPIO_CONST_CASE( 38 );
+#endif
+#if( _GPIO_PIN_COUNT > 39 )
+    _GPIO_CONST_CASE( 39 );
+#endif
+#if( _GPIO_PIN_COUNT > 40 )
+    _GPIO_CONST_CASE( 40 );
+#endif
+#if( _GPIO_PIN_COUNT > 41 )
+    _GPIO_CONST_CASE( 41 );
+#endif
+#if( _GPIO_PIN_COUNT > 42 )
+    _GPIO_CONST_CASE( 42 );
+#endif
+#if( _GPIO_PIN_COUNT > 43 )
+    _GPIO_CONST_CASE( 43 );
+#endif
+#if( _GPIO_PIN_COUNT > 44 )
+    _GPIO_CONST_CASE( 44 );
+#endif
+#if( _GPIO_PIN_COUNT > 45 )
+    _GPIO_CONST_CASE( 45 );
+#endif
+#if( _GPIO_PIN_COUNT > 46 )
+    _GPIO_CONST_CASE( 46 );
+#endif
+#if( _GPIO_PIN_COUNT > 47 )
+    _GPIO_CONST_CASE( 47 );
+#endif
+#if( _GPIO_PIN_COUNT > 48 )
+    _GPIO_CONST_CASE( 48 );
+#endif
+#if( _GPIO_PIN_COUNT > 49 )
+    _GPIO_CONST_CASE( 49 );
+#endif
+#if( _GPIO_PIN_COUNT > 50 )
+    _GPIO_CONST_CASE( 50 );
+#endif
+#if( _GPIO_PIN_COUNT > 51 )
+    _GPIO_CONST_CASE( 51 );
+#endif
+#if( _GPIO_PIN_COUNT > 52 )
+    _GPIO_CONST_CASE( 52 );
+#endif
+#if( _GPIO_PIN_COUNT > 53 )
+    _GPIO_CONST_CASE( 53 );
+#endif
+#if( _GPIO_PIN_COUNT > 54 )
+    _GPIO_CONST_CASE( 54 );
+#endif
+#if( _GPIO_PIN_COUNT > 55 )
+    _GPIO_CONST_CASE( 55 );
+#endif
+#if( _GPIO_PIN_COUNT > 56 )
+    _GPIO_CONST_CASE( 56 );
+#endif
+#if( _GPIO_PIN_COUNT > 57 )
+    _GPIO_CONST_CASE( 57 );
+#endif
+#if( _GPIO_PIN_COUNT > 58 )
+    _GPIO_CONST_CASE( 58 );
+#endif
+#if( _GPIO_PIN_COUNT > 59 )
+    _GPIO_CONST_CASE( 59 );
+#endif
+#if( _GPIO_PIN_COUNT > 60 )
+    _GPIO_CONST_CASE( 60 );
+#endif
+#if( _GPIO_PIN_COUNT > 61 )
+    _GPIO_CONST_CASE( 61 );
+#endif
+#if( _GPIO_PIN_COUNT > 62 )
+    _GPIO_CONST_CASE( 62 );
+#endif
+#if( _GPIO_PIN_COUNT > 63 )
+    _GPIO_CONST_CASE( 63 );
+#endif
+#if( _GPIO_PIN_COUNT > 64 )
+    _GPIO_CONST_CASE( 64 );
+#endif
+#if( _GPIO_PIN_COUNT > 65 )
+    _GPIO_CONST_CASE( 65 );
+#endif
+#if( _GPIO_PIN_COUNT > 66 )
+    _GPIO_CONST_CASE( 66 );
+#endif
+#if( _GPIO_PIN_COUNT > 67 )
+    _GPIO_CONST_CASE( 67 );
+#endif
+#if( _GPIO_PIN_COUNT > 68 )
+    _GPIO_CONST_CASE( 68 );
+#endif
+#if( _GPIO_PIN_COUNT > 69 )
+    _GPIO_CONST_CASE( 69 );
+#endif
+    default:
+        return( 0 );
+    }
+
+} /* _gpio_const_lookup() */
+
+
+/**
+ * @fn      gpio_fast_get_state( gpio_pin_t )
+ * @brief   Gets the state (low or high) of the specified GPIO pin.
+ * @note    Compiles to a single `sbis` / `sbic` for compile-time constant pins in the I/O space, and falls back to
+ *          `gpio_get_state()` otherwise.
+ */
+static inline __attribute__(( always_inline )) gpio_state_t gpio_fast_get_state( gpio_pin_t pin )
+{
+    if( __builtin_constant_p( pin ) && pin < GPIO_PIN_COUNT )
+    {
+        uint16_t reg = _gpio_const_lookup( pin );
+        return( is_bitmask_set( _GPIO_CONST_PIN( reg ), _GPIO_CONST_MASK( reg ) ) ?
+                GPIO_STATE_HIGH :
+                GPIO_STATE_LOW );
+    }
+    else
+    {
+        return( gpio_get_state( pin ) );
+    }
+
+} /* gpio_fast_get_state() */
+
+
+/**
+ * @fn      gpio_fast_set_dir( gpio_pin_t, gpio_dir_t )
+ * @brief   Sets the I/O direction (in or out) of the specified GPIO pin.
+ * @note    Compiles to a single `sbi` / `cbi` for compile-time constant pins and directions in the I/O space, and falls
+ *          back to `gpio_set_dir()` otherwise.
+ */
+static inline __attribute__(( always_inline )) void gpio_fast_set_dir( gpio_pin_t pin, gpio_dir_t dir )
+{
+    if( __builtin_constant_p( pin ) && pin < GPIO_PIN_COUNT )
+    {
+        uint16_t reg = _gpio_const_lookup( pin );
+        assign_bitmask( _GPIO_CONST_DDR( reg ), _GPIO_CONST_MASK( reg ), dir == GPIO_DIR_OUT );
+    }
+    else
+    {
+        gpio_set_dir( pin, dir );
+    }
+
+} /* gpio_fast_set_dir() */
+
+
+/**
+ * @fn      gpio_fast_set_state( gpio_pin_t, gpio_state_t )
+ * @brief   Sets the state (low or high) of the specified GPIO pin.
+ * @note    Compiles to a single `sbi` / `cbi` for compile-time constant pins and states in the I/O space, and falls back
+ *          to `gpio_set_state()` otherwise. Only the single-instruction case is atomic - use
+ *          `gpio_fast_set_state_atomic()` if the port is shared with an interrupt handler.
+ */
+static inline __attribute__(( always_inline )) void gpio_fast_set_state( gpio_pin_t pin, gpio_state_t state )
+{
+    if( __builtin_constant_p( pin ) && pin < GPIO_PIN_COUNT )
+    {
+        uint16_t reg = _gpio_const_lookup( pin );
+        assign_bitmask( _GPIO_CONST_PORT( reg ), _GPIO_CONST_MASK( reg ), state == GPIO_STATE_HIGH );
+    }
+    else
+    {
+        gpio_set_state( pin, state );
+    }
+
+} /* gpio_fast_set_state() */
+
+
+/**
+ * @fn      gpio_fast_set_state_atomic( gpio_pin_t, gpio_state_t )
+ * @brief   Sets the state (low or high) of the specified GPIO pin, safely against interrupt handlers modifying the same
+ *          port.
+ * @note    For compile-time constant pins on ports reachable by `sbi` / `cbi`, this is a single instruction and
+ *          interrupts are never disabled. Other ports (e.g., ports H through L on the ATmega2560) fall back to a
+ *          read-modify-write with interrupts disabled.
+ */
+static inline __attribute__(( always_inline )) void gpio_fast_set_state_atomic( gpio_pin_t pin, gpio_state_t state )
+{
+    if( __builtin_constant_p( pin ) && pin < GPIO_PIN_COUNT )
+    {
+        uint16_t reg = _gpio_const_lookup( pin );
+        if( _GPIO_CONST_PORT_IS_BIT_ADDRESSABLE( reg ) )
+        {
+            assign_bitmask( _GPIO_CONST_PORT( reg ), _GPIO_CONST_MASK( reg ), state == GPIO_STATE_HIGH );
+        }
+        else
+        {
+            bool int_en = is_bit_set( SREG, SREG_I );
+            if( int_en ) cli();
+            assign_bitmask( _GPIO_CONST_PORT( reg ), _GPIO_CONST_MASK( reg ), state == GPIO_STATE_HIGH );
+            if( int_en ) sei();
+        }
+    }
+    else
+    {
+        gpio_set_state_atomic( pin, state );
+    }
+
+} /* gpio_fast_set_state_atomic() */
+
+
+/**
+ * @fn      gpio_fast_toggle_state( gpio_pin_t )
+ * @brief   Toggles the state of the specified GPIO pin.
+ * @note    Writes the pin's bit to its PINx register directly for compile-time constant pins, and falls back to
+ *          `gpio_toggle_state()` otherwise. Either way, this is always atomic.
+ */
+static inline __attribute__(( always_inline )) void gpio_fast_toggle_state( gpio_pin_t pin )
+{
+    if( __builtin_constant_p( pin ) && pin < GPIO_PIN_COUNT )
+    {
+        uint16_t reg = _gpio_const_lookup( pin );
+        _GPIO_CONST_PIN( reg ) = _GPIO_CONST_MASK( reg );
+    }
+    else
+    {
+        gpio_toggle_state( pin );
+    }
+
+} /* gpio_fast_toggle_state() */
+
 #endif /* !defined( GPIO_GPIO_H ) */
@@ -0,0 +1,592 @@
+/**
+ * @file    kernel.c
+ * @brief   Implementation for the preemptive kernel library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "prr/prr.h"
+#include "zero/bit_ops.h"
+#include "zero/utility.h"
+
+#include "kernel.h"
+
+/* -- Macros -- */
+
+// The saved context includes EIND, and the return addresses on each stack are three bytes wide
+#if !defined( __AVR_ATmega2560__ )
+    #error "The kernel library is only supported on the ATmega2560!"
+#endif
+
+// Ensure configuration is valid
+_Static_assert( KERNEL_PRIORITY_COUNT >= 1 && KERNEL_PRIORITY_COUNT <= 8,
+                "KERNEL_PRIORITY_COUNT must be between 1 and 8!" );
+
+// Helper macros to validate arguments
+#define validate_priority( _prio )  validate_enum( _prio, KERNEL_PRIORITY_COUNT )
+
+// Number of timer counts per millisecond, with the /64 clock prescaler (250 at 16 MHz F_CPU)
+#define COUNTS_PER_MS               ( F_CPU / 64UL / 1000UL )
+
+// Number of CPU cycles per timer count
+#define CYCLES_PER_COUNT            ( 64 )
+
+// Initial value of SREG for a new task (interrupts enabled)
+#define INITIAL_SREG                bitmask( SREG_I )
+
+/**
+ * @def     SAVE_CONTEXT
+ * @brief   Pushes every register onto the current stack and saves the stack pointer into `s_current`.
+ * @note    Interrupts are disabled once SREG has been saved, and `r1` is cleared as the compiler expects.
+ */
+#define SAVE_CONTEXT()                                                          \
+    __asm__ __volatile__(                                                       \
+        "push  r0                    \n\t"                                      \
+        "in    r0, __SREG__          \n\t"                                      \
+        "cli                         \n\t"                                      \
+        "push  r0                    \n\t"                                      \
+        "in    r0, %[rampz]          \n\t"                                      \
+        "push  r0                    \n\t"                                      \
+        "in    r0, %[eind]           \n\t"                                      \
+        "push  r0                    \n\t"                                      \
+        "push  r1                    \n\t"                                      \
+        "clr   r1                    \n\t"                                      \
+        "push  r2 \n\t" "push  r3 \n\t" "push  r4 \n\t" "push  r5 \n\t"         \
+        "push  r6 \n\t" "push  r7 \n\t" "push  r8 \n\t" "push  r9 \n\t"         \
+        "push  r10\n\t" "push  r11\n\t" "push  r12\n\t" "push  r13\n\t"         \
+        "push  r14\n\t" "push  r15\n\t" "push  r16\n\t" "push  r17\n\t"         \
+        "push  r18\n\t" "push  r19\n\t" "push  r20\n\t" "push  r21\n\t"         \
+        "push  r22\n\t" "push  r23\n\t" "push  r24\n\t" "push  r25\n\t"         \
+        "push  r26\n\t" "push  r27\n\t" "push  r28\n\t" "push  r29\n\t"         \
+        "push  r30\n\t" "push  r31\n\t"                                         \
+        "lds   r26, %[cur]           \n\t"                                      \
+        "lds   r27, %[cur] + 1       \n\t"                                      \
+        "in    r0, __SP_L__          \n\t"                                      \
+        "st    x+, r0                \n\t"                                      \
+        "in    r0, __SP_H__          \n\t"                                      \
+        "st    x+, r0                \n\t"                                      \
+        :                                                                       \
+        : [rampz] "I" ( _SFR_IO_ADDR( RAMPZ ) ),                                \
+          [eind]  "I" ( _SFR_IO_ADDR( EIND ) ),                                 \
+          [cur]   "i" ( & s_current )                                           \
+    )
+
+/**
+ * @def     RESTORE_CONTEXT
+ * @brief   Loads the stack pointer from `s_current` and pops every register saved by `SAVE_CONTEXT()`.
+ * @note    The restored SREG determines whether interrupts are enabled afterwards.
+ */
+#define RESTORE_CONTEXT()                                                       \
+    __asm__ __volatile__(                                                       \
+        "lds   r26, %[cur]           \n\t"                                      \
+        "lds   r27, %[cur] + 1       \n\t"                                      \
+        "ld    r28, x+               \n\t"                                      \
+        "out   __SP_L__, r28         \n\t"                                      \
+        "ld    r29, x+               \n\t"                                      \
+        "out   __SP_H__, r29         \n\t"                                      \
+        "pop   r31\n\t" "pop   r30\n\t" "pop   r29\n\t" "pop   r28\n\t"         \
+        "pop   r27\n\t" "pop   r26\n\t" "pop   r25\n\t" "pop   r24\n\t"         \
+        "pop   r23\n\t" "pop   r22\n\t" "pop   r21\n\t" "pop   r20\n\t"         \
+        "pop   r19\n\t" "pop   r18\n\t" "pop   r17\n\t" "pop   r16\n\t"         \
+        "pop   r15\n\t" "pop   r14\n\t" "pop   r13\n\t" "pop   r12\n\t"         \
+        "pop   r11\n\t" "pop   r10\n\t" "pop   r9 \n\t" "pop   r8 \n\t"         \
+        "pop   r7 \n\t" "pop   r6 \n\t" "pop   r5 \n\t" "pop   r4 \n\t"         \
+        "pop   r3 \n\t" "pop   r2 \n\t"                                         \
+        "pop   r1                    \n\t"                                      \
+        "pop   r0                    \n\t"                                      \
+        "out   %[eind], r0           \n\t"                                      \
+        "pop   r0                    \n\t"                                      \
+        "out   %[rampz], r0          \n\t"                                      \
+        "pop   r0                    \n\t"                                      \
+        "out   __SREG__, r0          \n\t"                                      \
+        "pop   r0                    \n\t"                                      \
+        :                                                                       \
+        : [rampz] "I" ( _SFR_IO_ADDR( RAMPZ ) ),                                \
+          [eind]  "I" ( _SFR_IO_ADDR( EIND ) ),                                 \
+          [cur]   "i" ( & s_current )                                           \
+    )
+
+/* -- Variables -- */
+
+// Task at each priority, or NULL
+static kernel_task_t*           s_tasks[ KERNEL_PRIORITY_COUNT ];
+
+// Bitmask of priorities which are ready to run
+static uint8_t volatile         s_ready         = 0;
+
+// Context of the code which called kernel_start(), which runs whenever no other task is ready
+static kernel_task_t            s_idle          = { .priority = KERNEL_PRIORITY_COUNT };
+
+// Set once kernel_start() has been called
+static bool                     s_started       = false;
+
+// Task which is currently running (accessed by the context switch assembly)
+static kernel_task_t* volatile  s_current       = & s_idle;
+
+// Number of ticks since the kernel was started
+static uint16_t volatile        s_ticks         = 0;
+
+// Longest measured context switch, in timer counts
+static uint8_t volatile         s_switch_counts = 0;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      block( uint8_t* )
+ * @brief   Blocks the current task until it is woken, optionally adding it to the specified set of waiting priorities.
+ * @note    Interrupts must be disabled.
+ */
+static void block( uint8_t* waiting );
+
+/**
+ * @fn      measure( void )
+ * @brief   Records the time since the tick's compare match, if it is the longest seen so far.
+ */
+static void measure( void );
+
+/**
+ * @fn      push( kernel_queue_t*, void const* )
+ * @brief   Adds an item to the tail of the specified (non-full) queue.
+ */
+static void push( kernel_queue_t* queue, void const* item );
+
+/**
+ * @fn      schedule( void )
+ * @brief   Sets `s_current` to the highest priority task which is ready to run, or to the idle task.
+ */
+static void schedule( void );
+
+/**
+ * @fn      switch_tick( void )
+ * @brief   Saves the interrupted context, runs the kernel tick, and restores the context of the selected task.
+ * @note    This is called at the very start of the naked tick interrupt, so it returns into the `reti` of whichever
+ *          task's interrupt frame it restores.
+ */
+static void switch_tick( void ) __attribute__(( naked, noinline ));
+
+/**
+ * @fn      task_exit( void )
+ * @brief   Removes the current task from the kernel. This is the return address of every task function.
+ */
+static void task_exit( void ) __attribute__(( noreturn ));
+
+/**
+ * @fn      tick( void )
+ * @brief   Advances the tick count and readies every task whose delay has ended.
+ */
+static void tick( void );
+
+/**
+ * @fn      wake( uint8_t* )
+ * @brief   Readies the highest priority task in the specified (non-empty) set of waiting priorities.
+ * @returns The priority of the woken task.
+ * @note    Interrupts must be disabled.
+ */
+static uint8_t wake( uint8_t* waiting );
+
+/* -- Procedures -- */
+
+void kernel_delay( uint16_t ms )
+{
+    assert( s_current != & s_idle );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    cli();
+
+    s_current->wake_tick = s_ticks + ( ms > 0 ? ms : 1 );
+    s_current->delayed = true;
+    block( NULL );
+
+    if( int_en )
+        sei();
+
+} /* kernel_delay() */
+
+
+uint16_t kernel_get_switch_cycles( void )
+{
+    return( ( s_switch_counts + 1 ) * CYCLES_PER_COUNT );
+
+} /* kernel_get_switch_cycles() */
+
+
+uint16_t kernel_get_ticks( void )
+{
+    bool int_en = is_bit_set( SREG, SREG_I );
+    cli();
+    uint16_t ticks = s_ticks;
+    if( int_en )
+        sei();
+
+    return( ticks );
+
+} /* kernel_get_ticks() */
+
+
+void kernel_mutex_init( kernel_mutex_t* mutex )
+{
+    mutex->owner = NULL;
+    mutex->waiting = 0;
+
+} /* kernel_mutex_init() */
+
+
+void kernel_mutex_lock( kernel_mutex_t* mutex )
+{
+    assert( s_current != & s_idle );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    cli();
+
+    assert( mutex->owner != s_current );
+    if( mutex->owner == NULL )
+        mutex->owner = s_current;
+    else
+        // The mutex is handed over directly by kernel_mutex_unlock(), so it is held once this returns
+        block( & mutex->waiting );
+
+    if( int_en )
+        sei();
+
+} /* kernel_mutex_lock() */
+
+
+void kernel_mutex_unlock( kernel_mutex_t* mutex )
+{
+    bool int_en = is_bit_set( SREG, SREG_I );
+    cli();
+
+    assert( mutex->owner == s_current );
+    if( mutex->waiting == 0 )
+    {
+        mutex->owner = NULL;
+    }
+    else
+    {
+        // Hand the mutex directly to the highest priority waiter, so that a lower priority task can't take it first
+        uint8_t prio = wake( & mutex->waiting );
+        mutex->owner = s_tasks[ prio ];
+        if( prio < s_current->priority )
+            kernel_yield();
+    }
+
+    if( int_en )
+        sei();
+
+} /* kernel_mutex_unlock() */
+
+
+void kernel_queue_init( kernel_queue_t* queue, void* buf, uint8_t item_size, uint8_t capacity )
+{
+    assert( item_size != 0 && capacity != 0 );
+
+    queue->buf = buf;
+    queue->item_size = item_size;
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->count = 0;
+    queue->tx_waiting = 0;
+    queue->rx_waiting = 0;
+
+} /* kernel_queue_init() */
+
+
+void kernel_queue_receive( kernel_queue_t* queue, void* item )
+{
+    assert( s_current != & s_idle );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    cli();
+
+    // Another task may empty the queue again before a woken receiver runs, so the condition is checked each time
+    while( queue->count == 0 )
+        block( & queue->rx_waiting );
+
+    memcpy( item, & queue->buf[ queue->head * queue->item_size ], queue->item_size );
+    if( ++queue->head == queue->capacity )
+        queue->head = 0;
+    queue->count--;
+
+    if( queue->tx_waiting != 0 && wake( & queue->tx_waiting ) < s_current->priority )
+        kernel_yield();
+
+    if( int_en )
+        sei();
+
+} /* kernel_queue_receive() */
+
+
+void kernel_queue_send( kernel_queue_t* queue, void const* item )
+{
+    assert( s_current != & s_idle );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    cli();
+
+    while( queue->count == queue->capacity )
+        block( & queue->tx_waiting );
+
+    push( queue, item );
+    if( queue->rx_waiting != 0 && wake( & queue->rx_waiting ) < s_current->priority )
+        kernel_yield();
+
+    if( int_en )
+        sei();
+
+} /* kernel_queue_send() */
+
+
+bool kernel_queue_send_from_isr( kernel_queue_t* queue, void const* item )
+{
+    if( queue->count == queue->capacity )
+        return( false );
+
+    // The woken task is selected at the next tick (or when the running task blocks), rather than from this interrupt
+    push( queue, item );
+    if( queue->rx_waiting != 0 )
+        wake( & queue->rx_waiting );
+
+    return( true );
+
+} /* kernel_queue_send_from_isr() */
+
+
+void kernel_start( void )
+{
+    cli();
+
+    // Initialize timer 0 exactly as the event manager does in EVENT_MODE_PERIODIC:
+    // - Waveform generation mode set to CTC
+    // - Clock prescale set to /64
+    // - Compare register set to 249 (the period is OCR0A + 1 counts, so 1 millisecond at 16 MHz F_CPU)
+    prr_acquire( PRR_MODULE_TIMER0 );
+    set_bit( TCCR0A, WGM01 );
+    set_bit( TCCR0B, CS00 );
+    set_bit( TCCR0B, CS01 );
+    OCR0A = COUNTS_PER_MS - 1;
+
+    // The tick is half way through the period, well away from the event manager's interrupt, and late enough that the
+    // counter never wraps while a context switch is being measured
+    OCR0B = COUNTS_PER_MS / 2;
+    set_bit( TIMSK0, OCIE0B );
+
+    // Switch to the highest priority task - this returns (with interrupts enabled) once the idle task next runs
+    s_current = & s_idle;
+    s_started = true;
+    kernel_yield();
+    sei();
+
+} /* kernel_start() */
+
+
+void kernel_task_create( kernel_task_t* task, uint8_t prio, void* stack, uint16_t size, kernel_fn_t fn, void* arg )
+{
+    validate_priority( prio );
+    assert( size >= KERNEL_STACK_FRAME_SIZE );
+
+    // Paint the stack so that its high-water mark can be measured
+    memset( stack, KERNEL_STACK_PAINT, size );
+
+    task->stack = stack;
+    task->stack_size = size;
+    task->priority = prio;
+    task->delayed = false;
+
+    // Build a frame which RESTORE_CONTEXT() pops into the initial register values, before "returning" into the task
+    // function - which in turn returns into task_exit(). Return addresses are pushed low byte first, and are three
+    // bytes wide, with the high byte always zero for code in the first 128 KB.
+    uint16_t exit_addr = ( uint16_t )( uintptr_t )task_exit;
+    uint16_t fn_addr = ( uint16_t )( uintptr_t )fn;
+    uint16_t arg_addr = ( uint16_t )( uintptr_t )arg;
+
+    uint8_t* sp = task->stack + size - 1;
+    * sp-- = ( uint8_t )exit_addr;
+    * sp-- = ( uint8_t )( exit_addr >> 8 );
+    * sp-- = 0;
+    * sp-- = ( uint8_t )fn_addr;
+    * sp-- = ( uint8_t )( fn_addr >> 8 );
+    * sp-- = 0;
+
+    // r0, SREG, RAMPZ, EIND, then r1 through r31, with the argument in r24:r25
+    * sp-- = 0;
+    * sp-- = INITIAL_SREG;
+    * sp-- = 0;
+    * sp-- = 0;
+    for( uint8_t reg = 1; reg <= 31; reg++ )
+    {
+        if( reg == 24 )
+            * sp-- = ( uint8_t )arg_addr;
+        else if( reg == 25 )
+            * sp-- = ( uint8_t )( arg_addr >> 8 );
+        else
+            * sp-- = 0;
+    }
+    task->sp = ( uint16_t )( uintptr_t )sp;
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    cli();
+
+    assert( s_tasks[ prio ] == NULL );
+    s_tasks[ prio ] = task;
+    set_bit( s_ready, prio );
+
+    // A task created by a lower priority task (once the kernel is running) preempts it immediately
+    if( s_started && prio < s_current->priority )
+        kernel_yield();
+
+    if( int_en )
+        sei();
+
+} /* kernel_task_create() */
+
+
+uint16_t kernel_task_get_stack_unused( kernel_task_t const* task )
+{
+    // The stack grows down, so bytes at the bottom which still hold the paint have never been used
+    uint16_t unused = 0;
+    while( unused < task->stack_size && task->stack[ unused ] == KERNEL_STACK_PAINT )
+        unused++;
+
+    return( unused );
+
+} /* kernel_task_get_stack_unused() */
+
+
+__attribute__(( naked, noinline ))
+void kernel_yield( void )
+{
+    // The caller's return address is already on the stack, so this saves a frame identical to an interrupted task's
+    SAVE_CONTEXT();
+    schedule();
+    RESTORE_CONTEXT();
+    __asm__ __volatile__( "ret" );
+
+} /* kernel_yield() */
+
+
+ISR( TIMER0_COMPB_vect, ISR_NAKED )
+{
+    switch_tick();
+    reti();
+
+} /* ISR( TIMER0_COMPB_vect ) */
+
+
+static void block( uint8_t* waiting )
+{
+    clear_bit( s_ready, s_current->priority );
+    if( waiting != NULL )
+        set_bit( * waiting, s_current->priority );
+
+    kernel_yield();
+
+} /* block() */
+
+
+static void measure( void )
+{
+    // This runs just before the next task's context is restored, which is as close to the end of the switch as C code
+    // is able to get
+    uint8_t counts = TCNT0 - OCR0B;
+    if( counts > s_switch_counts )
+        s_switch_counts = counts;
+
+} /* measure() */
+
+
+static void push( kernel_queue_t* queue, void const* item )
+{
+    uint8_t tail = queue->head + queue->count;
+    if( tail >= queue->capacity )
+        tail -= queue->capacity;
+
+    memcpy( & queue->buf[ tail * queue->item_size ], item, queue->item_size );
+    queue->count++;
+
+} /* push() */
+
+
+static void schedule( void )
+{
+    uint8_t ready = s_ready;
+    if( ready == 0 )
+    {
+        s_current = & s_idle;
+        return;
+    }
+
+    uint8_t prio = 0;
+    while( is_bit_clear( ready, prio ) )
+        prio++;
+
+    s_current = s_tasks[ prio ];
+
+} /* schedule() */
+
+
+static void switch_tick( void )
+{
+    SAVE_CONTEXT();
+    tick();
+    schedule();
+    measure();
+    RESTORE_CONTEXT();
+    __asm__ __volatile__( "ret" );
+
+} /* switch_tick() */
+
+
+static void task_exit( void )
+{
+    cli();
+
+    clear_bit( s_ready, s_current->priority );
+    s_tasks[ s_current->priority ] = NULL;
+
+    // The task's context is never restored, so its stack may be reused as soon as this switches away
+    kernel_yield();
+    __builtin_unreachable();
+
+} /* task_exit() */
+
+
+static void tick( void )
+{
+    uint16_t ticks = ++s_ticks;
+    for( uint8_t prio = 0; prio < KERNEL_PRIORITY_COUNT; prio++ )
+    {
+        kernel_task_t* task = s_tasks[ prio ];
+        if( task == NULL || ! task->delayed || ( int16_t )( ticks - task->wake_tick ) < 0 )
+            continue;
+
+        task->delayed = false;
+        set_bit( s_ready, prio );
+    }
+
+} /* tick() */
+
+
+static uint8_t wake( uint8_t* waiting )
+{
+    uint8_t prio = 0;
+    while( is_bit_clear( * waiting, prio ) )
+        prio++;
+
+    clear_bit( * waiting, prio );
+    set_bit( s_ready, prio );
+
+    return( prio );
+
+} /* wake() */
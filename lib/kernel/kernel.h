@@ -0,0 +1,211 @@
+/**
+ * @file    kernel.h
+ * @brief   Header for the preemptive kernel library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * This library is a small preemptive kernel with fixed-priority tasks, each with its own stack. Each task has a unique
+ * priority, from 0 (highest) to `KERNEL_PRIORITY_COUNT - 1` (lowest), and the highest priority task which is ready to
+ * run always runs. Tasks of equal importance must therefore cooperate by blocking (on a delay, mutex, or queue) or by
+ * calling `kernel_yield()`.
+ *
+ * The kernel tick is the timer 0 compare B interrupt, half way through each 1 ms period of timer 0. Timer 0 is
+ * configured exactly as the event manager configures it in `EVENT_MODE_PERIODIC`, so the two may be used together -
+ * the code which calls `kernel_start()` continues as the idle task, below every other priority, and may run
+ * `event_run()` (with any mode) to handle events in its spare time. The idle task must never block, and must not sleep
+ * in any mode deeper than `SLEEP_MODE_IDLE`, since that would stop timer 0 (i.e., it must hold `EVENT_SLEEP_TIMER` if
+ * it runs `event_run()` in `EVENT_MODE_TICKLESS`).
+ *
+ * This library is only supported on the ATmega2560.
+ */
+
+#if !defined( KERNEL_KERNEL_H )
+#define KERNEL_KERNEL_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* -- Constants -- */
+
+/**
+ * @def     KERNEL_PRIORITY_COUNT
+ * @brief   Number of task priorities, which is also the maximum number of tasks. Must be between 1 and 8.
+ */
+#if !defined( KERNEL_PRIORITY_COUNT )
+    #define KERNEL_PRIORITY_COUNT   8
+#endif
+
+/**
+ * @def     KERNEL_STACK_FRAME_SIZE
+ * @brief   Number of bytes of a task's stack used by the kernel - the saved context, the return addresses of the tick
+ *          interrupt, and the return address of the task function.
+ * @note    Task stacks must be at least this large, plus the stack used by the task itself and by interrupt handlers.
+ */
+#define KERNEL_STACK_FRAME_SIZE     44
+
+/**
+ * @def     KERNEL_STACK_PAINT
+ * @brief   Value which unused task stack bytes are filled with, in order to measure stack usage.
+ */
+#define KERNEL_STACK_PAINT          0xA5
+
+/* -- Types -- */
+
+/**
+ * @typedef kernel_fn_t
+ * @brief   Entry point of a kernel task. The task exits if this function returns.
+ */
+typedef void ( * kernel_fn_t )( void* arg );
+
+/**
+ * @struct  kernel_task_t
+ * @brief   Struct containing the state of a single kernel task.
+ * @note    The contents of this struct should only be accessed through the procedures below.
+ */
+typedef struct
+{
+    uint16_t            sp;         /**< Saved stack pointer (must be the first field). */
+    uint8_t*            stack;      /**< Lowest address of the task's stack.            */
+    uint16_t            stack_size; /**< Size of the task's stack in bytes.             */
+    uint16_t            wake_tick;  /**< Tick at which the current delay ends.          */
+    uint8_t             priority;   /**< Priority of the task (0 is highest).           */
+    bool                delayed;    /**< Set if `wake_tick` is valid.                   */
+} kernel_task_t;
+
+/**
+ * @struct  kernel_mutex_t
+ * @brief   Struct containing the state of a mutex.
+ * @note    Mutexes do not implement priority inheritance, and must not be locked recursively.
+ */
+typedef struct
+{
+    kernel_task_t*      owner;      /**< Task which holds the mutex, or `NULL`.         */
+    uint8_t             waiting;    /**< Priorities of the tasks waiting for the mutex. */
+} kernel_mutex_t;
+
+/**
+ * @struct  kernel_queue_t
+ * @brief   Struct containing the state of a fixed-size message queue.
+ */
+typedef struct
+{
+    uint8_t*            buf;        /**< Item storage.                                  */
+    uint8_t             item_size;  /**< Size of each item in bytes.                    */
+    uint8_t             capacity;   /**< Maximum number of items.                       */
+    uint8_t             head;       /**< Index of the oldest item.                      */
+    uint8_t             count;      /**< Number of items queued.                        */
+    uint8_t             tx_waiting; /**< Priorities of the tasks waiting to send.       */
+    uint8_t             rx_waiting; /**< Priorities of the tasks waiting to receive.    */
+} kernel_queue_t;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      kernel_delay( uint16_t )
+ * @brief   Blocks the calling task for at least the specified number of milliseconds.
+ * @note    The delay must be less than 32768 ms.
+ */
+void kernel_delay( uint16_t ms );
+
+/**
+ * @fn      kernel_get_switch_cycles( void )
+ * @brief   Returns the longest measured time taken by the kernel tick, from the compare match until the next task's
+ *          context is about to be restored, in CPU cycles.
+ * @note    This is measured with timer 0, so it has a resolution of 64 cycles and is rounded up. Restoring the context
+ *          and returning from the interrupt takes a further 80 cycles or so.
+ */
+uint16_t kernel_get_switch_cycles( void );
+
+/**
+ * @fn      kernel_get_ticks( void )
+ * @brief   Returns the number of 1 ms kernel ticks since the kernel was started.
+ */
+uint16_t kernel_get_ticks( void );
+
+/**
+ * @fn      kernel_mutex_init( kernel_mutex_t* )
+ * @brief   Initializes the specified mutex in the unlocked state.
+ */
+void kernel_mutex_init( kernel_mutex_t* mutex );
+
+/**
+ * @fn      kernel_mutex_lock( kernel_mutex_t* )
+ * @brief   Locks the specified mutex, blocking the calling task until it is available.
+ */
+void kernel_mutex_lock( kernel_mutex_t* mutex );
+
+/**
+ * @fn      kernel_mutex_unlock( kernel_mutex_t* )
+ * @brief   Unlocks the specified mutex, which must be held by the calling task.
+ * @note    If any tasks are waiting for the mutex, it is handed directly to the highest priority one.
+ */
+void kernel_mutex_unlock( kernel_mutex_t* mutex );
+
+/**
+ * @fn      kernel_queue_init( kernel_queue_t*, void*, uint8_t, uint8_t )
+ * @brief   Initializes the specified queue, using `buf` (which must be `item_size * capacity` bytes) for storage.
+ */
+void kernel_queue_init( kernel_queue_t* queue, void* buf, uint8_t item_size, uint8_t capacity );
+
+/**
+ * @fn      kernel_queue_receive( kernel_queue_t*, void* )
+ * @brief   Removes the oldest item from the specified queue, blocking the calling task until one is available.
+ */
+void kernel_queue_receive( kernel_queue_t* queue, void* item );
+
+/**
+ * @fn      kernel_queue_send( kernel_queue_t*, void const* )
+ * @brief   Adds an item to the specified queue, blocking the calling task until there is space.
+ */
+void kernel_queue_send( kernel_queue_t* queue, void const* item );
+
+/**
+ * @fn      kernel_queue_send_from_isr( kernel_queue_t*, void const* )
+ * @brief   Adds an item to the specified queue from an interrupt handler, without blocking.
+ * @returns `false` if the queue is full, in which case the item is not added.
+ * @note    A task which was waiting for the item runs at the next kernel tick, or sooner if the running task blocks.
+ */
+bool kernel_queue_send_from_isr( kernel_queue_t* queue, void const* item );
+
+/**
+ * @fn      kernel_start( void )
+ * @brief   Starts the kernel tick and switches to the highest priority task. The caller continues as the idle task.
+ * @note    Global interrupts are enabled by this function.
+ */
+void kernel_start( void );
+
+/**
+ * @fn      kernel_task_create( kernel_task_t*, uint8_t, void*, uint16_t, kernel_fn_t, void* )
+ * @brief   Creates a task, which is ready to run immediately.
+ * @param   task
+ *          The task to create. Must remain valid until the task exits.
+ * @param   prio
+ *          The priority of the task, which must not be in use by any other task.
+ * @param   stack
+ *          The task's stack, which must remain valid until the task exits.
+ * @param   size
+ *          The size of `stack` in bytes. Must be at least `KERNEL_STACK_FRAME_SIZE`.
+ * @param   fn
+ *          The task's entry point.
+ * @param   arg
+ *          An arbitrary argument to pass to `fn`.
+ */
+void kernel_task_create( kernel_task_t* task, uint8_t prio, void* stack, uint16_t size, kernel_fn_t fn, void* arg );
+
+/**
+ * @fn      kernel_task_get_stack_unused( kernel_task_t const* )
+ * @brief   Returns the number of bytes of the specified task's stack which have never been used (the stack's high-water
+ *          mark, measured from the bottom).
+ */
+uint16_t kernel_task_get_stack_unused( kernel_task_t const* task );
+
+/**
+ * @fn      kernel_yield( void )
+ * @brief   Switches to the highest priority ready task, which may be the calling task.
+ */
+void kernel_yield( void );
+
+#endif /* !defined( KERNEL_KERNEL_H ) */
@@ -0,0 +1,151 @@
+/**
+ * @file    lcdtext-fb.c
+ * @brief   Implementation for the lcdtext framebuffer module.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "zero/bit_ops.h"
+
+#include "lcdtext.h"
+#include "lcdtext-fb.h"
+
+/* -- Macros -- */
+
+// Helper macros to access the dirty bitmap
+#define is_dirty( _fb, _idx )       is_bit_set( ( _fb )->dirty[ ( _idx ) >> 3 ], ( _idx ) & 0x07 )
+#define set_dirty( _fb, _idx )      set_bit( ( _fb )->dirty[ ( _idx ) >> 3 ], ( _idx ) & 0x07 )
+#define clear_dirty( _fb, _idx )    clear_bit( ( _fb )->dirty[ ( _idx ) >> 3 ], ( _idx ) & 0x07 )
+
+/* -- Procedures -- */
+
+void lcdtext_fb_clear( lcdtext_fb_t* fb )
+{
+    for( uint8_t row = 0; row < fb->rows; row++ )
+        lcdtext_fb_write_line( fb, row, "" );
+
+} /* lcdtext_fb_clear() */
+
+
+bool lcdtext_fb_flush( lcdtext_fb_t* fb )
+{
+    bool sent = false;
+    uint8_t next = fb->address;
+
+    // Rows are visited in DDRAM address order (1, 3, 2, 4), so that a run may continue from the end of one row onto the
+    // next row in DDRAM without another address instruction (e.g., from line 1 to line 3 of an LCD2004)
+    for( uint8_t first = 0; first < 2; first++ )
+    {
+        for( uint8_t row = first; row < fb->rows; row += 2 )
+        {
+            uint8_t addr = lcdtext_fb_get_address( fb, 0, row );
+            uint8_t idx = row * fb->cols;
+            for( uint8_t col = 0; col < fb->cols; col++, addr++, idx++ )
+            {
+                if( ! is_dirty( fb, idx ) )
+                    continue;
+
+                // The address counter only needs setting at the start of each run of changed cells
+                if( addr != next )
+                    lcdtext_set_address( fb->lcd, addr );
+                lcdtext_write_char( fb->lcd, fb->cells[ idx ] );
+                clear_dirty( fb, idx );
+
+                next = addr + 1;
+                sent = true;
+            }
+        }
+    }
+
+    fb->address = next;
+    return( sent );
+
+} /* lcdtext_fb_flush() */
+
+
+void lcdtext_fb_forget_address( lcdtext_fb_t* fb )
+{
+    fb->address = LCDTEXT_FB_ADDRESS_UNKNOWN;
+
+} /* lcdtext_fb_forget_address() */
+
+
+uint8_t lcdtext_fb_get_address( lcdtext_fb_t const* fb, uint8_t col, uint8_t row )
+{
+    // Lines 3 and 4 continue from the ends of lines 1 and 2 in DDRAM
+    uint8_t addr = ( is_bit_set( row, 0 ) ? LCDTEXT_ADDRESS_LINE_2 : LCDTEXT_ADDRESS_LINE_1 );
+    if( is_bit_set( row, 1 ) )
+        addr += fb->cols;
+
+    return( addr + col );
+
+} /* lcdtext_fb_get_address() */
+
+
+void lcdtext_fb_init( lcdtext_fb_t* fb, lcdtext_t const * lcd, uint8_t cols, uint8_t rows )
+{
+    assert( cols >= 1 && cols <= LCDTEXT_FB_MAX_COLS );
+    assert( rows == 1 || rows == 2 || rows == 4 );
+
+    fb->lcd = lcd;
+    fb->cols = cols;
+    fb->rows = rows;
+    fb->address = LCDTEXT_FB_ADDRESS_UNKNOWN;
+
+    // The LCD's contents are unknown, so every cell is sent by the first flush
+    memset( fb->cells, ' ', sizeof( fb->cells ) );
+    memset( fb->dirty, 0xFF, sizeof( fb->dirty ) );
+
+} /* lcdtext_fb_init() */
+
+
+void lcdtext_fb_put( lcdtext_fb_t* fb, uint8_t col, uint8_t row, char chr )
+{
+    assert( col < fb->cols && row < fb->rows );
+
+    uint8_t idx = row * fb->cols + col;
+    if( fb->cells[ idx ] == chr )
+        return;
+
+    fb->cells[ idx ] = chr;
+    set_dirty( fb, idx );
+
+} /* lcdtext_fb_put() */
+
+
+void lcdtext_fb_scroll( lcdtext_fb_t* fb )
+{
+    // Copied through lcdtext_fb_put(), so that cells which already match (e.g., blank space) stay clean
+    uint8_t idx = 0;
+    for( uint8_t row = 0; row + 1 < fb->rows; row++ )
+        for( uint8_t col = 0; col < fb->cols; col++, idx++ )
+            lcdtext_fb_put( fb, col, row, fb->cells[ idx + fb->cols ] );
+
+    lcdtext_fb_write_line( fb, fb->rows - 1, "" );
+
+} /* lcdtext_fb_scroll() */
+
+
+void lcdtext_fb_write( lcdtext_fb_t* fb, uint8_t col, uint8_t row, char const* str )
+{
+    for( ; * str != '\0' && col < fb->cols; col++ )
+        lcdtext_fb_put( fb, col, row, *( str++ ) );
+
+} /* lcdtext_fb_write() */
+
+
+void lcdtext_fb_write_line( lcdtext_fb_t* fb, uint8_t row, char const* str )
+{
+    for( uint8_t col = 0; col < fb->cols; col++ )
+        lcdtext_fb_put( fb, col, row, ( * str != '\0' ? *( str++ ) : ' ' ) );
+
+} /* lcdtext_fb_write_line() */
+
@@ -0,0 +1,138 @@
+/**
+ * @file    lcdtext-fb.h
+ * @brief   Header for the lcdtext framebuffer module.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * This module keeps a RAM copy of the characters shown on an LCD, along with a bitmap of the cells which have changed
+ * since they were last sent. Drawing into the framebuffer is free - nothing is sent to the LCD until it is flushed, and
+ * a flush only sends the cells which have actually changed. Contiguous changed cells are sent as a single run, which
+ * needs only one address instruction, and the display is never cleared, so there is no 2 ms clear instruction and no
+ * flicker.
+ *
+ * While a framebuffer is in use, it must be the only thing writing to its LCD's display data, and the LCD must use
+ * `LCDTEXT_AUTOSHIFT_CURSOR_RIGHT` with the display unshifted (i.e., the defaults set by `lcdtext_init()`). The
+ * framebuffer also remembers where each flush leaves the LCD's address counter, so that the next flush can skip the
+ * address instruction if it continues from the same place. Anything else which moves the address counter (e.g., a glyph
+ * upload) must be followed by a call to `lcdtext_fb_forget_address()`.
+ */
+
+#if !defined( LCDTEXT_LCDTEXT_FB_H )
+#define LCDTEXT_LCDTEXT_FB_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lcdtext.h"
+
+/* -- Constants -- */
+
+/**
+ * @def     LCDTEXT_FB_MAX_COLS
+ * @brief   Maximum number of columns in a framebuffer.
+ */
+#define LCDTEXT_FB_MAX_COLS         LCDTEXT_2004_LINE_LENGTH
+
+/**
+ * @def     LCDTEXT_FB_MAX_ROWS
+ * @brief   Maximum number of rows in a framebuffer.
+ */
+#define LCDTEXT_FB_MAX_ROWS         4
+
+/**
+ * @def     LCDTEXT_FB_MAX_CELLS
+ * @brief   Maximum number of cells in a framebuffer.
+ */
+#define LCDTEXT_FB_MAX_CELLS        ( LCDTEXT_FB_MAX_COLS * LCDTEXT_FB_MAX_ROWS )
+
+/**
+ * @def     LCDTEXT_FB_ADDRESS_UNKNOWN
+ * @brief   Value of `lcdtext_fb_t.address` when the LCD's address counter is unknown (DDRAM addresses are 7 bits).
+ */
+#define LCDTEXT_FB_ADDRESS_UNKNOWN  0xFF
+
+/* -- Types -- */
+
+/**
+ * @struct  lcdtext_fb_t
+ * @brief   Struct containing the state of a framebuffer.
+ * @note    The contents of this struct should only be accessed through the procedures below.
+ */
+typedef struct
+{
+    lcdtext_t const *   lcd;        /**< LCD which the framebuffer is flushed to.       */
+    uint8_t             cols;       /**< Number of columns (characters per line).       */
+    uint8_t             rows;       /**< Number of rows (lines).                        */
+    uint8_t             address;    /**< LCD's address counter, if known.               */
+    char                cells[ LCDTEXT_FB_MAX_CELLS ];
+                                    /**< Contents of each cell, row by row.             */
+    uint8_t             dirty[ LCDTEXT_FB_MAX_CELLS / 8 ];
+                                    /**< Bitmap of the cells which must be sent.        */
+} lcdtext_fb_t;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      lcdtext_fb_clear( lcdtext_fb_t* )
+ * @brief   Fills the specified framebuffer with spaces.
+ */
+void lcdtext_fb_clear( lcdtext_fb_t* fb );
+
+/**
+ * @fn      lcdtext_fb_flush( lcdtext_fb_t* )
+ * @brief   Sends every cell which has changed since the last flush to the LCD.
+ * @returns `true` if any cells were sent.
+ * @note    The cursor is left after the last cell sent, which is recorded in `address`.
+ */
+bool lcdtext_fb_flush( lcdtext_fb_t* fb );
+
+/**
+ * @fn      lcdtext_fb_forget_address( lcdtext_fb_t* )
+ * @brief   Marks the LCD's address counter as unknown, so that the next flush sets it.
+ * @note    This must be called after anything other than the framebuffer moves the LCD's address counter.
+ */
+void lcdtext_fb_forget_address( lcdtext_fb_t* fb );
+
+/**
+ * @fn      lcdtext_fb_get_address( lcdtext_fb_t const*, uint8_t, uint8_t )
+ * @brief   Returns the DDRAM address of the specified cell.
+ */
+uint8_t lcdtext_fb_get_address( lcdtext_fb_t const* fb, uint8_t col, uint8_t row );
+
+/**
+ * @fn      lcdtext_fb_init( lcdtext_fb_t*, lcdtext_t const *, uint8_t, uint8_t )
+ * @brief   Initializes the specified framebuffer for an LCD of the specified size, filled with spaces.
+ * @note    Supported sizes are up to 20 columns with 1, 2, or 4 rows (e.g., 16x2 and 20x4). Every cell is sent by the
+ *          first flush, so the LCD's existing contents do not need to be cleared.
+ */
+void lcdtext_fb_init( lcdtext_fb_t* fb, lcdtext_t const * lcd, uint8_t cols, uint8_t rows );
+
+/**
+ * @fn      lcdtext_fb_put( lcdtext_fb_t*, uint8_t, uint8_t, char )
+ * @brief   Sets the character in the specified cell.
+ */
+void lcdtext_fb_put( lcdtext_fb_t* fb, uint8_t col, uint8_t row, char chr );
+
+/**
+ * @fn      lcdtext_fb_scroll( lcdtext_fb_t* )
+ * @brief   Moves every row up by one, and fills the last row with spaces.
+ * @note    Only the cells whose contents actually change are sent by the next flush.
+ */
+void lcdtext_fb_scroll( lcdtext_fb_t* fb );
+
+/**
+ * @fn      lcdtext_fb_write( lcdtext_fb_t*, uint8_t, uint8_t, char const* )
+ * @brief   Writes the specified null-terminated string starting at the specified cell, clipped to the end of the row.
+ */
+void lcdtext_fb_write( lcdtext_fb_t* fb, uint8_t col, uint8_t row, char const* str );
+
+/**
+ * @fn      lcdtext_fb_write_line( lcdtext_fb_t*, uint8_t, char const* )
+ * @brief   Replaces the specified row with the specified null-terminated string, padded with spaces.
+ */
+void lcdtext_fb_write_line( lcdtext_fb_t* fb, uint8_t row, char const* str );
+
+#endif /* !defined( LCDTEXT_LCDTEXT_FB_H ) */
@@ -0,0 +1,149 @@
+/**
+ * @file    lcdtext-glyph.c
+ * @brief   Implementation for the lcdtext custom glyph module.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <avr/pgmspace.h>
+
+#include "lcdtext.h"
+#include "lcdtext-glyph.h"
+
+/* -- Constants -- */
+
+// CGRAM characters are mirrored at codes 0x08 to 0x0F, which avoids using '\0'
+#define GLYPH_CODE_BASE             0x08
+
+// Character in the LCD's ROM which has every pixel set
+#define CHAR_FULL_BLOCK             ( ( char )0xFF )
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      touch( lcdtext_glyph_cache_t*, uint8_t )
+ * @brief   Marks the specified slot as the most recently used.
+ */
+static void touch( lcdtext_glyph_cache_t* cache, uint8_t slot );
+
+/**
+ * @fn      upload( lcdtext_glyph_cache_t*, uint8_t, uint8_t const* )
+ * @brief   Uploads the specified glyph to the specified slot.
+ */
+static void upload( lcdtext_glyph_cache_t* cache, uint8_t slot, uint8_t const* glyph );
+
+/* -- Variables -- */
+
+// Glyphs for partially filled bar graph cells, with 1 to 4 columns filled from the left
+static uint8_t const s_bar_glyphs[ LCDTEXT_GLYPH_COLS - 1 ][ LCDTEXT_GLYPH_ROWS ] PROGMEM =
+{
+    { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 },
+    { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 },
+    { 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C },
+    { 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E },
+};
+
+/* -- Procedures -- */
+
+void lcdtext_glyph_bar( lcdtext_glyph_cache_t* cache, char* buf, uint8_t width, uint8_t level )
+{
+    // Number of filled pixel columns across the whole bar
+    uint16_t pixels = ( uint16_t )( ( uint32_t )level * width * LCDTEXT_GLYPH_COLS / UINT8_MAX );
+
+    for( uint8_t idx = 0; idx < width; idx++ )
+    {
+        if( pixels >= LCDTEXT_GLYPH_COLS )
+        {
+            buf[ idx ] = CHAR_FULL_BLOCK;
+            pixels -= LCDTEXT_GLYPH_COLS;
+        }
+        else if( pixels != 0 )
+        {
+            buf[ idx ] = lcdtext_glyph_get( cache, s_bar_glyphs[ pixels - 1 ] );
+            pixels = 0;
+        }
+        else
+        {
+            buf[ idx ] = ' ';
+        }
+    }
+    buf[ width ] = '\0';
+
+} /* lcdtext_glyph_bar() */
+
+
+char lcdtext_glyph_get( lcdtext_glyph_cache_t* cache, uint8_t const* glyph )
+{
+    uint8_t slot;
+    for( slot = 0; slot < LCDTEXT_GLYPH_SLOT_COUNT; slot++ )
+        if( cache->glyphs[ slot ] == glyph )
+            break;
+
+    // On a miss, the least recently used slot is replaced
+    if( slot == LCDTEXT_GLYPH_SLOT_COUNT )
+    {
+        for( slot = 0; cache->ranks[ slot ] != LCDTEXT_GLYPH_SLOT_COUNT - 1; slot++ )
+            ;
+        upload( cache, slot, glyph );
+    }
+
+    touch( cache, slot );
+    return( ( char )( GLYPH_CODE_BASE + slot ) );
+
+} /* lcdtext_glyph_get() */
+
+
+void lcdtext_glyph_init( lcdtext_glyph_cache_t* cache, lcdtext_t const * lcd )
+{
+    cache->lcd = lcd;
+    cache->uploaded = false;
+
+    // The ranks are a permutation of the slots, so that exactly one slot is least recently used
+    for( uint8_t slot = 0; slot < LCDTEXT_GLYPH_SLOT_COUNT; slot++ )
+    {
+        cache->glyphs[ slot ] = NULL;
+        cache->ranks[ slot ] = LCDTEXT_GLYPH_SLOT_COUNT - 1 - slot;
+    }
+
+} /* lcdtext_glyph_init() */
+
+
+bool lcdtext_glyph_was_uploaded( lcdtext_glyph_cache_t* cache )
+{
+    bool uploaded = cache->uploaded;
+    cache->uploaded = false;
+
+    return( uploaded );
+
+} /* lcdtext_glyph_was_uploaded() */
+
+
+static void touch( lcdtext_glyph_cache_t* cache, uint8_t slot )
+{
+    uint8_t rank = cache->ranks[ slot ];
+    for( uint8_t idx = 0; idx < LCDTEXT_GLYPH_SLOT_COUNT; idx++ )
+        if( cache->ranks[ idx ] < rank )
+            cache->ranks[ idx ]++;
+
+    cache->ranks[ slot ] = 0;
+
+} /* touch() */
+
+
+static void upload( lcdtext_glyph_cache_t* cache, uint8_t slot, uint8_t const* glyph )
+{
+    lcdtext_set_cgram_address( cache->lcd, slot * LCDTEXT_GLYPH_ROWS );
+    for( uint8_t row = 0; row < LCDTEXT_GLYPH_ROWS; row++ )
+        lcdtext_write_char( cache->lcd, ( char )pgm_read_byte( & glyph[ row ] ) );
+
+    cache->glyphs[ slot ] = glyph;
+    cache->uploaded = true;
+
+} /* upload() */
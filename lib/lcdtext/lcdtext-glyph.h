@@ -0,0 +1,100 @@
+/**
+ * @file    lcdtext-glyph.h
+ * @brief   Header for the lcdtext custom glyph module.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * The LCD has room for 8 custom characters in its CGRAM. This module lets an application use any number of custom
+ * glyphs (bitmaps in program memory), by caching which glyph occupies each CGRAM slot - a glyph is only uploaded the
+ * first time it is used, or if it has since been evicted by another glyph. When every slot is occupied, the least
+ * recently used glyph is evicted.
+ *
+ * A character which is already on the display changes if its slot is reused for another glyph, so an application which
+ * displays more than 8 distinct glyphs at once will see some of them change.
+ */
+
+#if !defined( LCDTEXT_LCDTEXT_GLYPH_H )
+#define LCDTEXT_LCDTEXT_GLYPH_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lcdtext.h"
+
+/* -- Constants -- */
+
+/**
+ * @def     LCDTEXT_GLYPH_SLOT_COUNT
+ * @brief   Number of CGRAM slots for custom glyphs.
+ */
+#define LCDTEXT_GLYPH_SLOT_COUNT    8
+
+/**
+ * @def     LCDTEXT_GLYPH_ROWS
+ * @brief   Number of rows (bytes) in a glyph bitmap.
+ */
+#define LCDTEXT_GLYPH_ROWS          8
+
+/**
+ * @def     LCDTEXT_GLYPH_COLS
+ * @brief   Number of columns (pixels) in each row of a glyph. The leftmost column is bit 4 of each row.
+ */
+#define LCDTEXT_GLYPH_COLS          5
+
+/* -- Types -- */
+
+/**
+ * @struct  lcdtext_glyph_cache_t
+ * @brief   Struct containing the state of the CGRAM slots of an LCD.
+ * @note    The contents of this struct should only be accessed through the procedures below.
+ */
+typedef struct
+{
+    lcdtext_t const *   lcd;        /**< LCD whose CGRAM is managed.                    */
+    uint8_t const*      glyphs[ LCDTEXT_GLYPH_SLOT_COUNT ];
+                                    /**^ Glyph in each slot (in program memory).        */
+    uint8_t             ranks[ LCDTEXT_GLYPH_SLOT_COUNT ];
+                                    /**^ Recency of each slot (0 is most recent).       */
+    bool                uploaded;   /**< Set if a glyph has been uploaded.              */
+} lcdtext_glyph_cache_t;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      lcdtext_glyph_bar( lcdtext_glyph_cache_t*, char*, uint8_t, uint8_t )
+ * @brief   Fills `buf` with a null-terminated horizontal bar graph, `width` characters wide, filled in proportion to
+ *          `level` (from 0 to 255).
+ * @note    The bar has a resolution of `LCDTEXT_GLYPH_COLS` pixels per character. It needs at most one partial cell
+ *          glyph at a time, and the 4 partial cell glyphs stay cached while the bar moves, unless other glyphs evict
+ *          them. `buf` must have room for `width + 1` characters.
+ */
+void lcdtext_glyph_bar( lcdtext_glyph_cache_t* cache, char* buf, uint8_t width, uint8_t level );
+
+/**
+ * @fn      lcdtext_glyph_get( lcdtext_glyph_cache_t*, uint8_t const* )
+ * @brief   Returns the character code for the specified glyph (`LCDTEXT_GLYPH_ROWS` bytes in program memory), uploading
+ *          it to the least recently used slot if it is not already in CGRAM.
+ * @note    The returned code is never `'\0'`, so it may be used in strings. If the glyph is uploaded, the LCD's address
+ *          counter is left in CGRAM, so the DDRAM address must be set before any more text is written - use
+ *          `lcdtext_glyph_was_uploaded()` to check whether that is the case (e.g., in order to call
+ *          `lcdtext_fb_forget_address()` only when necessary).
+ */
+char lcdtext_glyph_get( lcdtext_glyph_cache_t* cache, uint8_t const* glyph );
+
+/**
+ * @fn      lcdtext_glyph_init( lcdtext_glyph_cache_t*, lcdtext_t const * )
+ * @brief   Initializes the specified cache for the specified LCD, with every slot empty.
+ */
+void lcdtext_glyph_init( lcdtext_glyph_cache_t* cache, lcdtext_t const * lcd );
+
+/**
+ * @fn      lcdtext_glyph_was_uploaded( lcdtext_glyph_cache_t* )
+ * @brief   Returns `true` if any glyph has been uploaded since the last call, leaving the LCD's address counter in
+ *          CGRAM.
+ */
+bool lcdtext_glyph_was_uploaded( lcdtext_glyph_cache_t* cache );
+
+#endif /* !defined( LCDTEXT_LCDTEXT_GLYPH_H ) */
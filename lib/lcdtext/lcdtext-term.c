@@ -0,0 +1,114 @@
+/**
+ * @file    lcdtext-term.c
+ * @brief   Implementation for the lcdtext terminal module.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lcdtext.h"
+#include "lcdtext-fb.h"
+#include "lcdtext-term.h"
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      new_line( lcdtext_term_t* )
+ * @brief   Moves the cursor to the start of the next line, scrolling if it is on the last line.
+ */
+static void new_line( lcdtext_term_t* term );
+
+/* -- Procedures -- */
+
+void lcdtext_term_clear( lcdtext_term_t* term )
+{
+    lcdtext_fb_clear( & term->fb );
+    lcdtext_term_set_cursor( term, 0, 0 );
+
+} /* lcdtext_term_clear() */
+
+
+bool lcdtext_term_flush( lcdtext_term_t* term )
+{
+    bool sent = lcdtext_fb_flush( & term->fb );
+
+    // With a wrap pending, the LCD's cursor is shown on the last column
+    uint8_t col = ( term->col < term->fb.cols ? term->col : term->fb.cols - 1 );
+    uint8_t addr = lcdtext_fb_get_address( & term->fb, col, term->row );
+    if( addr != term->fb.address )
+    {
+        lcdtext_set_address( term->fb.lcd, addr );
+        term->fb.address = addr;
+        sent = true;
+    }
+
+    return( sent );
+
+} /* lcdtext_term_flush() */
+
+
+void lcdtext_term_init( lcdtext_term_t* term, lcdtext_t const * lcd, uint8_t cols, uint8_t rows )
+{
+    lcdtext_fb_init( & term->fb, lcd, cols, rows );
+    term->col = 0;
+    term->row = 0;
+
+} /* lcdtext_term_init() */
+
+
+void lcdtext_term_put( lcdtext_term_t* term, char chr )
+{
+    switch( chr )
+    {
+    case '\n':
+        new_line( term );
+        break;
+
+    case '\r':
+        term->col = 0;
+        break;
+
+    default:
+        if( term->col == term->fb.cols )
+            new_line( term );
+        lcdtext_fb_put( & term->fb, term->col, term->row, chr );
+        term->col++;
+        break;
+    }
+
+} /* lcdtext_term_put() */
+
+
+void lcdtext_term_set_cursor( lcdtext_term_t* term, uint8_t col, uint8_t row )
+{
+    assert( col < term->fb.cols && row < term->fb.rows );
+
+    term->col = col;
+    term->row = row;
+
+} /* lcdtext_term_set_cursor() */
+
+
+void lcdtext_term_write( lcdtext_term_t* term, char const* str )
+{
+    while( * str != '\0' )
+        lcdtext_term_put( term, *( str++ ) );
+
+} /* lcdtext_term_write() */
+
+
+static void new_line( lcdtext_term_t* term )
+{
+    term->col = 0;
+    if( term->row + 1 < term->fb.rows )
+        term->row++;
+    else
+        lcdtext_fb_scroll( & term->fb );
+
+} /* new_line() */
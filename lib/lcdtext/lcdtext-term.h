@@ -0,0 +1,92 @@
+/**
+ * @file    lcdtext-term.h
+ * @brief   Header for the lcdtext terminal module.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * This module is a simple terminal on top of a framebuffer. It tracks the cursor in software, so text is placed by row
+ * and column rather than by DDRAM address - on an LCD2004, text wraps from line 1 onto line 2 (rather than line 3, as
+ * the LCD's address counter does), and writing past the last line scrolls the contents up. Scrolling is done in the
+ * framebuffer, so only the cells whose contents actually change are sent.
+ *
+ * The following control characters are handled:
+ *
+ * - `'\n'` moves the cursor to the start of the next line, scrolling if it is already on the last line.
+ * - `'\r'` moves the cursor to the start of the current line.
+ *
+ * Wrapping is deferred, as on most terminals - after a character is written to the last column, the cursor stays on
+ * that line until the next character is written. A full line followed by `'\n'` therefore does not leave a blank line.
+ */
+
+#if !defined( LCDTEXT_LCDTEXT_TERM_H )
+#define LCDTEXT_LCDTEXT_TERM_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lcdtext.h"
+#include "lcdtext-fb.h"
+
+/* -- Types -- */
+
+/**
+ * @struct  lcdtext_term_t
+ * @brief   Struct containing the state of a terminal.
+ * @note    The contents of this struct should only be accessed through the procedures below, except that `fb` may be
+ *          drawn into directly.
+ */
+typedef struct
+{
+    lcdtext_fb_t        fb;         /**< Framebuffer with the terminal's contents.      */
+    uint8_t             col;        /**< Column of the cursor (`cols` if wrap pending). */
+    uint8_t             row;        /**< Row of the cursor.                             */
+} lcdtext_term_t;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      lcdtext_term_clear( lcdtext_term_t* )
+ * @brief   Fills the specified terminal with spaces, and moves the cursor to the top left.
+ */
+void lcdtext_term_clear( lcdtext_term_t* term );
+
+/**
+ * @fn      lcdtext_term_flush( lcdtext_term_t* )
+ * @brief   Sends every cell which has changed since the last flush to the LCD, and then moves the LCD's cursor to the
+ *          terminal's cursor.
+ * @returns `true` if any instructions were sent.
+ * @note    The address instruction which moves the LCD's cursor is skipped if the LCD's address counter is already in
+ *          the right place, as it is after typing at the end of a line.
+ */
+bool lcdtext_term_flush( lcdtext_term_t* term );
+
+/**
+ * @fn      lcdtext_term_init( lcdtext_term_t*, lcdtext_t const *, uint8_t, uint8_t )
+ * @brief   Initializes the specified terminal for an LCD of the specified size, filled with spaces, with the cursor at
+ *          the top left.
+ * @note    Supported sizes are the same as for `lcdtext_fb_init()`.
+ */
+void lcdtext_term_init( lcdtext_term_t* term, lcdtext_t const * lcd, uint8_t cols, uint8_t rows );
+
+/**
+ * @fn      lcdtext_term_put( lcdtext_term_t*, char )
+ * @brief   Writes the specified character (or control character) at the cursor.
+ */
+void lcdtext_term_put( lcdtext_term_t* term, char chr );
+
+/**
+ * @fn      lcdtext_term_set_cursor( lcdtext_term_t*, uint8_t, uint8_t )
+ * @brief   Moves the cursor to the specified cell.
+ */
+void lcdtext_term_set_cursor( lcdtext_term_t* term, uint8_t col, uint8_t row );
+
+/**
+ * @fn      lcdtext_term_write( lcdtext_term_t*, char const* )
+ * @brief   Writes the specified null-terminated string at the cursor.
+ */
+void lcdtext_term_write( lcdtext_term_t* term, char const* str );
+
+#endif /* !defined( LCDTEXT_LCDTEXT_TERM_H ) */
@@ -9,17 +9,58 @@
 /* -- Includes -- */
 
 #include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
+#include <avr/interrupt.h>
+#include <avr/io.h>
 #include <util/delay.h>
 
+#include "event/event.h"
 #include "gpio/gpio.h"
+#include "prr/prr.h"
 #include "zero/bit_ops.h"
 #include "zero/utility.h"
 
 #include "lcdtext.h"
 
+/* -- Constants -- */
+
+// Timer 2 runs with a /256 prescaler (16 us per count at 16 MHz)
+#define TIMER_CLOCK                 bitmask2( CS22, CS21 )
+#define TIMER_PRESCALE              256UL
+#define COUNTS_PER_MS               ( ( F_CPU / TIMER_PRESCALE + 999UL ) / 1000UL )
+#define COUNTS_US( _us )            ( ( ( _us ) * COUNTS_PER_MS + 999UL ) / 1000UL )
+
+// Shortest wait in timer counts - writing TCNT2 blocks a compare match on the next timer clock, so a wait of 1 count
+// (OCR2A = 0) would not match until the counter had wrapped through all 256 counts
+#define WAIT_MIN                    2
+
+// Number of timer counts to wait for the LCD to execute each type of instruction
+#define WAIT_SHORT                  ( ( uint8_t )COUNTS_US( 50UL ) )
+#define WAIT_LONG                   ( ( uint8_t )COUNTS_US( 2000UL ) )
+#define WAIT_NONE                   WAIT_MIN
+#define WAIT_POLL                   WAIT_MIN
+
+// Minimum times for the enable line to be held high (PW_EH) and low (the rest of the 1000 ns enable cycle time), in
+// microseconds - these are converted to cycles from F_CPU, so they hold however fast the port accesses are
+#define ENABLE_HIGH_US              0.45
+#define ENABLE_LOW_US               0.55
+
+// Bit of the status register which is set while the LCD is executing an instruction
+#define STATUS_BUSY                 7
+
+// Mask for the address counter in the status register
+#define STATUS_ADDRESS_MASK         0x7F
+
+// Number of values of a 4-bit data bus
+#define NIBBLE_COUNT                16
+
+// Mask to convert a free-running queue counter to an index
+#define QUEUE_MASK                 ( LCDTEXT_QUEUE_SIZE - 1 )
+
 /* -- Types -- */
 
 /**
@@ -39,31 +80,121 @@ enum
     LCD_REGISTER_DATA,
 };
 
+/**
+ * @typedef entry_kind_t
+ * @brief   Enumeration of the kinds of queue entry.
+ */
+typedef uint8_t entry_kind_t;
+enum
+{
+    ENTRY_DATA,                     /**< Data byte (i.e., a character).                 */
+    ENTRY_COMMAND,                  /**< Instruction with a short execution time.       */
+    ENTRY_COMMAND_LONG,             /**< Instruction with a long execution time.        */
+    ENTRY_COMMAND_TIMED,            /**< Instruction which can't be polled for.         */
+};
+
+/**
+ * @struct  entry_t
+ * @brief   Struct containing a single queue entry.
+ */
+typedef struct
+{
+    uint8_t             value;      /**< Instruction or data byte to send.              */
+    entry_kind_t        kind;       /**< Kind of entry.                                 */
+} entry_t;
+
 /* -- Macros -- */
 
+// Helper macro to get the PORTx register for a pin (which follows PINx and DDRx)
+#define PORT_REGISTER( _pin )               ( gpio_get_pin_register( _pin ) + 2 )
+
 // Helper macros to validate arguments
 #define validate_autoshift( _autoshift )    validate_enum( _autoshift,  LCDTEXT_AUTOSHIFT_COUNT )
 #define validate_cursor( _cursor )          validate_enum( _cursor,     LCDTEXT_CURSOR_COUNT )
 
+// Ensure configuration is valid
+_Static_assert( COUNTS_US( 2000UL ) <= 256, "Timer 2 prescaler is too small for F_CPU!" );
+_Static_assert( COUNTS_US( 50UL ) >= WAIT_MIN, "Timer 2 prescaler is too large for F_CPU!" );
+_Static_assert( LCDTEXT_QUEUE_SIZE >= 1 && LCDTEXT_QUEUE_SIZE <= 128 && ( LCDTEXT_QUEUE_SIZE & QUEUE_MASK ) == 0,
+                "LCDTEXT_QUEUE_SIZE must be a power of 2 no greater than 128!" );
+
+/* -- Variables -- */
+
+// LCD which the state machine is driving, or `NULL` if none has been initialized
+static lcdtext_t const * volatile   s_lcd = NULL;
+
+// Instructions and characters waiting to be sent, indexed by free-running counters
+static entry_t                      s_queue[ LCDTEXT_QUEUE_SIZE ];
+static volatile uint8_t             s_head = 0;
+static volatile uint8_t             s_tail = 0;
+
+// Event to post each time the queue has been drained, or `EVENT_NONE`
+static event_t                      s_idle_event = EVENT_NONE;
+
+// Number of additional milliseconds to wait after each character (only changed while idle)
+static uint16_t                     s_char_delay_ms = 0;
+
+// Number of whole milliseconds remaining after the current timer period
+static volatile uint16_t            s_wait_ms = 0;
+
+// Set if the busy flag may be polled for the entry which was sent last
+static volatile bool                s_polling = false;
+
+// Set while timer 2 is running (i.e., the LCD is executing an instruction, or entries are waiting)
+static volatile bool                s_busy = false;
+
 /* -- Procedure Prototypes -- */
 
 /**
- * @fn      delay_long( void )
- * @brief   Performs a long synchronous delay.
+ * @fn      arm( uint8_t )
+ * @brief   Restarts the current timer period, with a length of the specified number of counts.
+ * @note    The length must be at least `WAIT_MIN` counts.
  */
-static void delay_long( void );
+static void arm( uint8_t counts );
 
 /**
- * @fn      delay_short( void )
- * @brief   Performs a short synchronous delay.
+ * @fn      can_read( lcd_p )
+ * @brief   Returns `true` if the specified LCD's RW line is wired, so that its status can be read.
  */
-static void delay_short( void );
+static bool can_read( lcd_p lcd );
 
 /**
- * @fn      delay_variable( uint16_t )
- * @brief   Delays for a variable number of milliseconds.
+ * @fn      compile_bus( lcdtext_t* )
+ * @brief   Computes the register access plan for the specified LCD's bus.
  */
-static void delay_variable( uint16_t delay_ms );
+static void compile_bus( lcdtext_t* lcd );
+
+/**
+ * @fn      entry_wait( lcd_p, entry_kind_t )
+ * @brief   Returns the number of timer counts to wait after sending an entry, before the LCD may be ready again.
+ * @note    If the busy flag can be read, it is polled instead of waiting for the worst case execution time.
+ */
+static uint8_t entry_wait( lcd_p lcd, entry_kind_t kind );
+
+/**
+ * @fn      kick( void )
+ * @brief   Starts the state machine, if it isn't already running, so that it sends any waiting entries.
+ */
+static void kick( void );
+
+/**
+ * @fn      poll( void )
+ * @brief   Advances the state machine if it is due and interrupts are disabled, so that waits cannot deadlock.
+ */
+static void poll( void );
+
+/**
+ * @fn      queue( uint8_t, entry_kind_t )
+ * @brief   Adds an entry to the queue, waiting for space if necessary.
+ */
+static void queue( uint8_t value, entry_kind_t kind );
+
+/**
+ * @fn      read_status( lcd_p )
+ * @brief   Reads the status register of the specified LCD (the busy flag and the address counter).
+ * @note    The RW line must be wired.
+ */
+static uint8_t read_status( lcd_p lcd );
 
 /**
  * @fn      select_register( lcd_p )
@@ -71,6 +202,18 @@ static void delay_variable( uint16_t delay_ms );
  */
 static void select_register( lcd_p lcd, lcd_register_t reg );
 
+/**
+ * @fn      select_target( lcd_p, uint16_t )
+ * @brief   Selects the LCD and character delay for subsequent entries, once any waiting entries have been sent.
+ */
+static void select_target( lcd_p lcd, uint16_t delay_ms );
+
+/**
+ * @fn      send_command( lcd_p, uint8_t, entry_kind_t )
+ * @brief   Queues the specified instruction for the LCD.
+ */
+static void send_command( lcd_p lcd, uint8_t command, entry_kind_t kind );
+
 /**
  * @fn      send_data( lcd_p, uint8_t )
  * @brief   Sends the specified data byte to the LCD.
@@ -84,22 +227,17 @@ static void send_data( lcd_p lcd, uint8_t data );
 static void send_function_select( lcd_p lcd );
 
 /**
- * @fn      set_data_4bit_hi( lcd_p, uint8_t )
- * @brief   Sets the 4-bit data bus to the high 4 bits of `data`.
+ * @fn      start( uint8_t, uint16_t )
+ * @brief   Starts the timer for a wait of the specified number of counts, followed by `ms` whole milliseconds.
+ * @note    The state machine must be idle, and the timer must not be able to fire until this function returns.
  */
-static void set_data_4bit_hi( lcd_p lcd, uint8_t data );
+static void start( uint8_t counts, uint16_t ms );
 
 /**
- * @fn      set_data_4bit_lo( lcd_p, uint8_t )
- * @brief   Sets the 4-bit data bus to the low 4 bits of `data`.
+ * @fn      step( void )
+ * @brief   Advances the state machine at the end of a timer period.
  */
-static void set_data_4bit_lo( lcd_p lcd, uint8_t data );
-
-/**
- * @fn      set_data_8bit( lcd_p, uint8_t )
- * @brief   Sets the 8-bit data bus to the content of `data`.
- */
-static void set_data_8bit( lcd_p lcd, uint8_t data );
+static void step( void );
 
 /**
  * @fn      strobe_enable( lcd_p )
@@ -107,19 +245,46 @@ static void set_data_8bit( lcd_p lcd, uint8_t data );
  */
 static void strobe_enable( lcd_p lcd );
 
+/**
+ * @fn      strobe_read( lcd_p )
+ * @brief   Strobes the enable line for the LCD while it is driving the data bus, and returns the value read.
+ */
+static uint8_t strobe_read( lcd_p lcd );
+
+/**
+ * @fn      wait_idle( void )
+ * @brief   Waits until the state machine is idle, and every entry has been sent and executed.
+ */
+static void wait_idle( void );
+
+/**
+ * @fn      write_data( lcd_p, uint8_t )
+ * @brief   Sets the data bus to the specified value (the low 4 bits only, for a 4-bit data bus).
+ */
+static void write_data( lcd_p lcd, uint8_t value );
+
 /* -- Procedures -- */
 
 void lcdtext_clear( lcdtext_t const * lcd )
 {
     static uint8_t const COMMAND = 0x01;
 
-    select_register( lcd, LCD_REGISTER_INSTRUCTION );
-    send_data( lcd, COMMAND );
-    delay_long();
+    send_command( lcd, COMMAND, ENTRY_COMMAND_LONG );
 
 } /* lcdtext_clear() */
 
 
+uint8_t lcdtext_get_space( lcdtext_t const * lcd )
+{
+    // Switching LCD or character delay waits for the queue to drain, so nothing can be queued without blocking
+    if( s_busy && ( lcd != s_lcd || s_char_delay_ms != 0 ) )
+        return( 0 );
+
+    return( LCDTEXT_QUEUE_SIZE - ( uint8_t )( s_head - s_tail ) );
+
+} /* lcdtext_get_space() */
+
+
 void lcdtext_go_line_1( lcdtext_t const * lcd )
 {
     lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_1 );
@@ -152,15 +317,22 @@ void lcdtext_home( lcdtext_t const * lcd )
 {
     static uint8_t const COMMAND = 0x02;
 
-    select_register( lcd, LCD_REGISTER_INSTRUCTION );
-    send_data( lcd, COMMAND );
-    delay_long();
+    send_command( lcd, COMMAND, ENTRY_COMMAND_LONG );
 
 } /* lcdtext_home() */
 
 
-void lcdtext_init( lcdtext_t const * lcd )
+void lcdtext_init( lcdtext_t * lcd )
 {
+    wait_idle();
+
+    // Precompute the data bus group (the data pins are contiguous in the pinout) and the register access plan
+    if( lcd->config.data_8 )
+        gpio_group_init( & lcd->data, & lcd->pins.d0, 8 );
+    else
+        gpio_group_init( & lcd->data, & lcd->pins.d4, 4 );
+    compile_bus( lcd );
+
     // Configure all GPIO pins
     gpio_config_t config = { GPIO_DIR_OUT, GPIO_STATE_LOW };
     for( uint8_t idx = 0; idx < LCDTEXT_PIN_COUNT; idx++ )
@@ -183,13 +355,32 @@ void lcdtext_init( lcdtext_t const * lcd )
 } /* lcdtext_init() */
 
 
+bool lcdtext_is_busy( lcdtext_t const * lcd )
+{
+    return( s_busy && s_lcd == lcd );
+
+} /* lcdtext_is_busy() */
+
+
+bool lcdtext_read_address( lcdtext_t const * lcd, uint8_t* addr )
+{
+    if( ! can_read( lcd ) )
+        return( false );
+
+    // The status register is only valid once the LCD has finished executing
+    wait_idle();
+    * addr = read_status( lcd ) & STATUS_ADDRESS_MASK;
+
+    return( true );
+
+} /* lcdtext_read_address() */
+
+
 void lcdtext_set_address( lcdtext_t const * lcd, uint8_t addr )
 {
     uint8_t command = 0x80 | ( 0x7F & addr );
 
-    select_register( lcd, LCD_REGISTER_INSTRUCTION );
-    send_data( lcd, command );
-    delay_short();
+    send_command( lcd, command, ENTRY_COMMAND );
 
 } /* lcdtext_set_address() */
 
@@ -217,13 +408,20 @@ void lcdtext_set_autoshift( lcdtext_t const * lcd, lcdtext_autoshift_t autoshift
         return;
     }
 
-    select_register( lcd, LCD_REGISTER_INSTRUCTION );
-    send_data( lcd, command );
-    delay_short();
+    send_command( lcd, command, ENTRY_COMMAND );
 
 } /* lcdtext_set_autoshift() */
 
 
+void lcdtext_set_cgram_address( lcdtext_t const * lcd, uint8_t addr )
+{
+    uint8_t command = 0x40 | ( 0x3F & addr );
+
+    send_command( lcd, command, ENTRY_COMMAND );
+
+} /* lcdtext_set_cgram_address() */
+
+
 void lcdtext_set_display( lcdtext_t const * lcd, bool display_on, lcdtext_cursor_t cursor )
 {
     validate_cursor( cursor );
@@ -233,20 +431,23 @@ void lcdtext_set_display( lcdtext_t const * lcd, bool display_on, lcdtext_cursor
     assign_bit( command, 1, cursor == LCDTEXT_CURSOR_UNDERSCORE || cursor == LCDTEXT_CURSOR_BOTH );
     assign_bit( command, 0, cursor == LCDTEXT_CURSOR_BOX        || cursor == LCDTEXT_CURSOR_BOTH );
 
-    select_register( lcd, LCD_REGISTER_INSTRUCTION );
-    send_data( lcd, command );
-    delay_short();
+    send_command( lcd, command, ENTRY_COMMAND );
 
 } /* lcdtext_set_display() */
 
 
+void lcdtext_set_idle_event( event_t event )
+{
+    s_idle_event = event;
+
+} /* lcdtext_set_idle_event() */
+
+
 void lcdtext_shift_left( lcdtext_t const * lcd )
 {
     static uint8_t const COMMAND = 0x18;
 
-    select_register( lcd, LCD_REGISTER_INSTRUCTION );
-    send_data( lcd, COMMAND );
-    delay_short();
+    send_command( lcd, COMMAND, ENTRY_COMMAND );
 
 } /* lcdtext_shift_left() */
 
@@ -255,13 +456,22 @@ void lcdtext_shift_right( lcdtext_t const * lcd )
 {
     static uint8_t const COMMAND = 0x1C;
 
-    select_register( lcd, LCD_REGISTER_INSTRUCTION );
-    send_data( lcd, COMMAND );
-    delay_short();
+    send_command( lcd, COMMAND, ENTRY_COMMAND );
 
 } /* lcdtext_shift_right() */
 
 
+bool lcdtext_try_write( lcdtext_t const * lcd, char const * str )
+{
+    if( strlen( str ) > lcdtext_get_space( lcd ) )
+        return( false );
+
+    lcdtext_write( lcd, str );
+    return( true );
+
+} /* lcdtext_try_write() */
+
+
 void lcdtext_write( lcdtext_t const * lcd, char const * str )
 {
     lcdtext_write_delay( lcd, str, 0 );
@@ -269,19 +479,31 @@ void lcdtext_write( lcdtext_t const * lcd, char const * str )
 } /* lcdtext_write() */
 
 
+void lcdtext_write_char( lcdtext_t const * lcd, char chr )
+{
+    select_target( lcd, 0 );
+    queue( chr, ENTRY_DATA );
+
+} /* lcdtext_write_char() */
+
+
 void lcdtext_write_delay( lcdtext_t const * lcd, char const * str, uint16_t delay_ms )
 {
-    select_register( lcd, LCD_REGISTER_DATA );
+    select_target( lcd, delay_ms );
     while( * str )
-    {
-        send_data( lcd, *( str++ ) );
-        delay_short();
-        delay_variable( delay_ms );
-    }
+        queue( *( str++ ), ENTRY_DATA );
 
 } /* lcdtext_write_delay() */
 
 
+void lcdtext_wait( lcdtext_t const * lcd )
+{
+    while( lcdtext_is_busy( lcd ) )
+        poll();
+
+} /* lcdtext_wait() */
+
+
 void lcdtext_1602_write_lines( lcdtext_t const * lcd, char const * line1, char const * line2 )
 {
     lcdtext_clear( lcd );
@@ -299,50 +521,190 @@ void lcdtext_1602_write_lines( lcdtext_t const * lcd, char const * line1, char c
 } /* lcdtext_write_lines() */
 
 
-static void delay_long( void )
+static void arm( uint8_t counts )
+{
+    assert( counts >= WAIT_MIN );
+
+    TCNT2 = 0;
+    OCR2A = counts - 1;
+
+} /* arm() */
+
+
+static bool can_read( lcd_p lcd )
 {
-    static const uint8_t DELAY_MS = 2;
-    _delay_ms( DELAY_MS );
+    return( lcd->pins.rw != GPIO_PIN_INVALID );
 
-} /* delay_long() */
+} /* can_read() */
 
 
-static void delay_short( void )
+static void compile_bus( lcdtext_t* lcd )
 {
-    static const uint8_t DELAY_US = 50;
-    _delay_us( DELAY_US );
+    lcdtext_bus_t* bus = & lcd->bus;
+    gpio_pin_t const * pins = ( lcd->config.data_8 ? & lcd->pins.d0 : & lcd->pins.d4 );
+    uint8_t pin_count = ( lcd->config.data_8 ? 8 : 4 );
+
+    // The control pins are written through cached registers, rather than being looked up on every access
+    bus->rs_port = PORT_REGISTER( lcd->pins.rs );
+    bus->rs_mask = gpio_get_pin_mask( lcd->pins.rs );
+    bus->e_port = PORT_REGISTER( lcd->pins.e );
+    bus->e_mask = gpio_get_pin_mask( lcd->pins.e );
+
+    // The data bus can be written with a single store if all of its pins share a port - an 8-bit bus has too many
+    // values for a lookup table, so it must also be wired in order (e.g., D0 to D7 on PD0 to PD7)
+    register_t port = PORT_REGISTER( pins[ 0 ] );
+    uint8_t mask = 0;
+    for( uint8_t bit = 0; bit < pin_count; bit++ )
+    {
+        uint8_t pin_mask = gpio_get_pin_mask( pins[ bit ] );
+        if( PORT_REGISTER( pins[ bit ] ) != port || ( lcd->config.data_8 && pin_mask != bitmask( bit ) ) )
+        {
+            port = NULL;
+            break;
+        }
+        mask |= pin_mask;
+    }
+    bus->data_port = port;
+    bus->data_mask = mask;
 
-} /* delay_short() */
+    // A 4-bit bus may be wired in any order, since each nibble is translated to port bits by a lookup table
+    if( port == NULL || lcd->config.data_8 )
+        return;
+    for( uint8_t value = 0; value < NIBBLE_COUNT; value++ )
+    {
+        uint8_t bits = 0;
+        for( uint8_t bit = 0; bit < pin_count; bit++ )
+            if( is_bit_set( value, bit ) )
+                bits |= gpio_get_pin_mask( pins[ bit ] );
+        bus->nibble[ value ] = bits;
+    }
+
+} /* compile_bus() */
 
 
-static void delay_variable( uint16_t delay_ms )
+static uint8_t entry_wait( lcd_p lcd, entry_kind_t kind )
 {
-    uint16_t LOOPS_PER_MS = ( F_CPU / 4000UL );
-    while( delay_ms -- )
-        _delay_loop_2( LOOPS_PER_MS );
+    if( kind == ENTRY_COMMAND_TIMED )
+        return( WAIT_SHORT );
+    if( can_read( lcd ) )
+        return( WAIT_POLL );
+
+    return( kind == ENTRY_COMMAND_LONG ? WAIT_LONG : WAIT_SHORT );
 
-} /* delay_variable() */
+} /* entry_wait() */
+
+
+static void kick( void )
+{
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en )
+        cli();
+
+    if( ! s_busy )
+        start( WAIT_NONE, 0 );
+
+    if( int_en )
+        sei();
+
+} /* kick() */
+
+
+static void poll( void )
+{
+    // With interrupts disabled (e.g., during initialization), the interrupt can't fire, so the flag is handled here
+    if( is_bit_clear( SREG, SREG_I ) && is_bit_set( TIFR2, OCF2A ) )
+    {
+        TIFR2 = bitmask( OCF2A );
+        step();
+    }
+
+} /* poll() */
+
+
+static void queue( uint8_t value, entry_kind_t kind )
+{
+    // Wait for space in the queue - the state machine is already running if it is full
+    uint8_t head = s_head;
+    while( ( uint8_t )( head - s_tail ) >= LCDTEXT_QUEUE_SIZE )
+        poll();
+
+    s_queue[ head & QUEUE_MASK ].value = value;
+    s_queue[ head & QUEUE_MASK ].kind = kind;
+
+    // The entry must be complete before it is published to the state machine
+    compiler_barrier();
+    s_head = head + 1;
+    kick();
+
+} /* queue() */
+
+
+static uint8_t read_status( lcd_p lcd )
+{
+    // The data bus must be released before the LCD starts driving it
+    gpio_group_set_dir( & lcd->data, GPIO_DIR_IN );
+    select_register( lcd, LCD_REGISTER_INSTRUCTION );
+    gpio_set_state( lcd->pins.rw, GPIO_STATE_HIGH );
+
+    uint8_t status;
+    if( lcd->config.data_8 )
+    {
+        status = strobe_read( lcd );
+    }
+    else
+    {
+        status = strobe_read( lcd ) << 4;
+        status |= strobe_read( lcd );
+    }
+
+    gpio_set_state( lcd->pins.rw, GPIO_STATE_LOW );
+    gpio_group_set_dir( & lcd->data, GPIO_DIR_OUT );
+
+    return( status );
+
+} /* read_status() */
 
 
 static void select_register( lcd_p lcd, lcd_register_t reg )
 {
-    gpio_set_state( lcd->pins.rs, ( reg == LCD_REGISTER_DATA ? GPIO_STATE_HIGH : GPIO_STATE_LOW ) );
+    assign_bitmask( * lcd->bus.rs_port, lcd->bus.rs_mask, reg == LCD_REGISTER_DATA );
 
 } /* select_register() */
 
 
-void send_data( lcd_p lcd, uint8_t data )
+static void select_target( lcd_p lcd, uint16_t delay_ms )
+{
+    // The state machine only drives a single LCD, with a single character delay, at a time
+    if( lcd != s_lcd || delay_ms != s_char_delay_ms )
+    {
+        wait_idle();
+        s_lcd = lcd;
+        s_char_delay_ms = delay_ms;
+    }
+
+} /* select_target() */
+
+
+static void send_command( lcd_p lcd, uint8_t command, entry_kind_t kind )
+{
+    select_target( lcd, s_char_delay_ms );
+    queue( command, kind );
+
+} /* send_command() */
+
+
+static void send_data( lcd_p lcd, uint8_t data )
 {
     if( lcd->config.data_8 )
     {
-        set_data_8bit( lcd, data );
+        write_data( lcd, data );
         strobe_enable( lcd );
     }
     else
     {
-        set_data_4bit_hi( lcd, data );
+        write_data( lcd, data >> 4 );
         strobe_enable( lcd );
-        set_data_4bit_lo( lcd, data );
+        write_data( lcd, data & 0x0F );
         strobe_enable( lcd );
     }
 
@@ -359,55 +721,127 @@ static void send_function_select( lcd_p lcd )
     if( lcd->config.font_large )
         set_bit( command, 2 );
 
-    select_register( lcd, LCD_REGISTER_INSTRUCTION );
-    send_data( lcd, command );
-    delay_short();
+    // The busy flag can't be read until the data bus width has been set, so this always waits for the worst case
+    send_command( lcd, command, ENTRY_COMMAND_TIMED );
 
 } /* send_function_select() */
 
 
-static void set_data_4bit_hi( lcd_p lcd, uint8_t data )
+static void start( uint8_t counts, uint16_t ms )
+{
+    // Hold the timer's sleep requirement first, since the interrupt may release it as soon as the timer starts
+    s_busy = true;
+    event_sleep_acquire( EVENT_SLEEP_TIMER );
+
+    // Timer 2 times the LCD's instructions in CTC mode, and is only powered while the state machine is running
+    prr_acquire( PRR_MODULE_TIMER2 );
+    TCCR2A = bitmask( WGM21 );
+
+    s_wait_ms = ms;
+    s_polling = false;
+    arm( counts );
+    TIFR2 = bitmask( OCF2A );
+    set_bit( TIMSK2, OCIE2A );
+    TCCR2B = TIMER_CLOCK;
+
+} /* start() */
+
+
+static void step( void )
+{
+    // Whole milliseconds are counted out one timer period at a time
+    if( s_wait_ms != 0 )
+    {
+        s_wait_ms--;
+        arm( COUNTS_PER_MS );
+        return;
+    }
+
+    // Keep polling until the LCD has finished, if it is able to report that it is busy
+    if( s_polling && is_bit_set( read_status( s_lcd ), STATUS_BUSY ) )
+    {
+        arm( WAIT_POLL );
+        return;
+    }
+
+    // Send the next entry, if there is one
+    uint8_t tail = s_tail;
+    if( tail != s_head )
+    {
+        entry_t const * entry = & s_queue[ tail & QUEUE_MASK ];
+        select_register( s_lcd, ( entry->kind == ENTRY_DATA ? LCD_REGISTER_DATA : LCD_REGISTER_INSTRUCTION ) );
+        send_data( s_lcd, entry->value );
+        s_wait_ms = ( entry->kind == ENTRY_DATA ? s_char_delay_ms : 0 );
+        s_polling = ( can_read( s_lcd ) && entry->kind != ENTRY_COMMAND_TIMED );
+        arm( entry_wait( s_lcd, entry->kind ) );
+
+        s_tail = tail + 1;
+        return;
+    }
+
+    // Nothing left to do - stop and power down the timer until the next entry
+    TCCR2B = 0;
+    clear_bit( TIMSK2, OCIE2A );
+    prr_release( PRR_MODULE_TIMER2 );
+    s_busy = false;
+    event_sleep_release( EVENT_SLEEP_TIMER );
+
+    if( s_idle_event != EVENT_NONE )
+        event_set_pending( s_idle_event );
+
+} /* step() */
+
+
+static void strobe_enable( lcd_p lcd )
 {
-    gpio_set_state( lcd->pins.d4, is_bit_set( data, 4 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d5, is_bit_set( data, 5 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d6, is_bit_set( data, 6 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d7, is_bit_set( data, 7 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
+    clear_bitmask( * lcd->bus.e_port, lcd->bus.e_mask );
+    _delay_us( ENABLE_LOW_US );
+    set_bitmask( * lcd->bus.e_port, lcd->bus.e_mask );
+    _delay_us( ENABLE_HIGH_US );
+    clear_bitmask( * lcd->bus.e_port, lcd->bus.e_mask );
 
-} /* set_data_4bit_hi() */
+} /* strobe_enable() */
 
 
-static void set_data_4bit_lo( lcd_p lcd, uint8_t data )
+static uint8_t strobe_read( lcd_p lcd )
 {
-    gpio_set_state( lcd->pins.d4, is_bit_set( data, 0 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d5, is_bit_set( data, 1 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d6, is_bit_set( data, 2 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d7, is_bit_set( data, 3 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
+    // The data is valid at most 360 ns after the enable line rises, which is within the minimum high time
+    set_bitmask( * lcd->bus.e_port, lcd->bus.e_mask );
+    _delay_us( ENABLE_HIGH_US );
+    uint8_t data = gpio_group_read( & lcd->data );
+    clear_bitmask( * lcd->bus.e_port, lcd->bus.e_mask );
+    _delay_us( ENABLE_LOW_US );
+
+    return( data );
 
-} /* set_data_4bit_lo() */
+} /* strobe_read() */
 
 
-static void set_data_8bit( lcd_p lcd, uint8_t data )
+static void wait_idle( void )
 {
-    gpio_set_state( lcd->pins.d0, is_bit_set( data, 0 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d1, is_bit_set( data, 1 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d2, is_bit_set( data, 2 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d3, is_bit_set( data, 3 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d4, is_bit_set( data, 4 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d5, is_bit_set( data, 5 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d6, is_bit_set( data, 6 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( lcd->pins.d7, is_bit_set( data, 7 ) ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
+    while( s_busy )
+        poll();
 
-} /* set_data_8bit() */
+} /* wait_idle() */
 
 
-static void strobe_enable( lcd_p lcd )
+static void write_data( lcd_p lcd, uint8_t value )
 {
-    static uint8_t const DELAY_LOOPS = 1;
+    lcdtext_bus_t const * bus = & lcd->bus;
+    if( bus->data_port == NULL )
+    {
+        gpio_group_write( & lcd->data, value );
+        return;
+    }
 
-    gpio_set_state( lcd->pins.e, GPIO_STATE_LOW );
-    _delay_loop_1( DELAY_LOOPS );
-    gpio_set_state( lcd->pins.e, GPIO_STATE_HIGH );
-    _delay_loop_1( DELAY_LOOPS );
-    gpio_set_state( lcd->pins.e, GPIO_STATE_LOW );
+    uint8_t bits = ( lcd->config.data_8 ? value : bus->nibble[ value ] );
+    * bus->data_port = ( * bus->data_port & ~bus->data_mask ) | bits;
 
-} /* strobe_enable() */
+} /* write_data() */
+
+
+ISR( TIMER2_COMPA_vect )
+{
+    step();
+
+} /* ISR( TIMER2_COMPA_vect ) */
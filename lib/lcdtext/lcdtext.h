@@ -4,6 +4,20 @@
  *
  * @author  Chris Vig (chris@invictus.so)
  * @date    2025-08-08
+ *
+ * Instructions and characters are sent to the LCD asynchronously - each procedure adds its instructions to a queue and
+ * returns immediately, and the timer 2 compare A interrupt sends them in the background, as quickly as the LCD is able
+ * to execute them. A procedure only blocks if the queue is full (which may be checked in advance with
+ * `lcdtext_get_space()`), or if it must wait for the queue to drain before switching to another LCD. The completion of
+ * the queue may be signalled with an event (see `lcdtext_set_idle_event()`). Timer 2 is only powered (with
+ * `prr_acquire()`) while the queue is being sent.
+ *
+ * The timer's compare A interrupt must not be used by the application, and any other pins on the same ports as the LCD
+ * must be written with `gpio_set_state_atomic()`.
+ *
+ * If the RW line is wired (i.e., `pins.rw` is not `GPIO_PIN_INVALID`), the LCD's busy flag is polled to find out when
+ * each instruction has finished, which is usually far sooner than the worst case times in the datasheet. Otherwise,
+ * RW must be tied low, and the worst case time is always waited.
  */
 
 #if !defined( LCDTEXT_LCDTEXT_H )
@@ -14,10 +28,20 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "event/event.h"
 #include "gpio/gpio.h"
+#include "zero/register.h"
 
 /* -- Constants -- */
 
+/**
+ * @def     LCDTEXT_QUEUE_SIZE
+ * @brief   Number of instructions and characters which may be waiting to be sent. Must be a power of 2, up to 128.
+ */
+#if !defined( LCDTEXT_QUEUE_SIZE )
+    #define LCDTEXT_QUEUE_SIZE      32
+#endif
+
 /**
  * @def     LCDTEXT_PIN_COUNT
  * @brief   Total number of GPIO pins for the LCD 1602 / 2004 modules.
@@ -130,6 +154,23 @@ typedef union
 // Ensure struct was correctly sized
 _Static_assert( sizeof( lcdtext_pins_t ) == sizeof( gpio_pin_t ) * LCDTEXT_PIN_COUNT, "Wrong struct size!" );
 
+/**
+ * @struct  lcdtext_bus_t
+ * @brief   Struct containing the precompiled register access plan for an LCD's bus.
+ * @note    The contents of this struct are computed by `lcdtext_init()` and should not be modified directly.
+ */
+typedef struct
+{
+    register_t          data_port;  /**< Data bus PORTx, or `NULL` to use the group.    */
+    uint8_t             data_mask;  /**< Bitmask of the data pins on `data_port`.       */
+    uint8_t             nibble[ 16 ];
+                                    /**^ Port bits for each value of a 4-bit data bus.  */
+    register_t          rs_port;    /**< PORTx register for the RS pin.                 */
+    uint8_t             rs_mask;    /**< Bitmask of the RS pin on `rs_port`.            */
+    register_t          e_port;     /**< PORTx register for the E pin.                  */
+    uint8_t             e_mask;     /**< Bitmask of the E pin on `e_port`.              */
+} lcdtext_bus_t;
+
 /**
  * @struct  lcdtext_t
  * @brief   Struct containing configuration information for an LCDTEXT module.
@@ -138,6 +179,8 @@ typedef struct
 {
     lcdtext_config_t    config;     /**< Module configuration.                          */
     lcdtext_pins_t      pins;       /**< Module pinout.                                 */
+    gpio_group_t        data;       /**< Data bus group, set by `lcdtext_init()`.       */
+    lcdtext_bus_t       bus;        /**< Bus access plan, set by `lcdtext_init()`.      */
 } lcdtext_t;
 
 /* -- Procedure Prototypes -- */
@@ -148,6 +191,12 @@ typedef struct
  */
 void lcdtext_clear( lcdtext_t const * lcd );
 
+/**
+ * @fn      lcdtext_get_space( lcdtext_t const * )
+ * @brief   Returns the number of instructions or characters which may be sent to the specified LCD without blocking.
+ */
+uint8_t lcdtext_get_space( lcdtext_t const * lcd );
+
 /**
  * @fn      lcdtext_go_line_1( lcdtext_t const * )
  * @brief   Moves the cursor to the beginning of line 1.
@@ -181,10 +230,25 @@ void lcdtext_go_line_4( lcdtext_t const * lcd );
 void lcdtext_home( lcdtext_t const * lcd );
 
 /**
- * @fn      lcdtext_init( lcdtext_t const * )
+ * @fn      lcdtext_init( lcdtext_t * )
  * @brief   Initializes all GPIO pins for the specified LCD.
+ * @note    The `config` and `pins` members must be set before calling this function. Interrupts may be disabled, in
+ *          which case this function (and any other which has to wait for the LCD) polls the timer instead.
  */
-void lcdtext_init( lcdtext_t const * lcd );
+void lcdtext_init( lcdtext_t * lcd );
+
+/**
+ * @fn      lcdtext_is_busy( lcdtext_t const * )
+ * @brief   Returns `true` if the specified LCD is executing an instruction, or has instructions or characters queued.
+ */
+bool lcdtext_is_busy( lcdtext_t const * lcd );
+
+/**
+ * @fn      lcdtext_read_address( lcdtext_t const *, uint8_t* )
+ * @brief   Reads the current DDRAM (or CGRAM) address from the specified LCD, once it has finished executing.
+ * @returns `false` if the LCD's RW line is not wired, in which case `addr` is not modified.
+ */
+bool lcdtext_read_address( lcdtext_t const * lcd, uint8_t* addr );
 
 /**
  * @fn      lcdtext_set_addr( lcdtext_t const *, uint8_t )
@@ -198,6 +262,14 @@ void lcdtext_set_address( lcdtext_t const * lcd, uint8_t addr );
  */
 void lcdtext_set_autoshift( lcdtext_t const * lcd, lcdtext_autoshift_t autoshift );
 
+/**
+ * @fn      lcdtext_set_cgram_address( lcdtext_t const *, uint8_t )
+ * @brief   Sets the CGRAM address for the specified LCD, so that subsequent writes define custom characters.
+ * @note    Custom character `n` occupies the 8 bytes from address `n * 8`, one byte per row with the leftmost pixel in
+ *          bit 4. The DDRAM address must be set again before any more text is written.
+ */
+void lcdtext_set_cgram_address( lcdtext_t const * lcd, uint8_t addr );
+
 /**
  * @fn      lcdtext_set_display( lcdtext_t const *, bool, bool, bool )
  * @brief   Sets the display mode for the specified LCD.
@@ -210,6 +282,13 @@ void lcdtext_set_autoshift( lcdtext_t const * lcd, lcdtext_autoshift_t autoshift
  */
 void lcdtext_set_display( lcdtext_t const * lcd, bool display_on, lcdtext_cursor_t cursor );
 
+/**
+ * @fn      lcdtext_set_idle_event( event_t )
+ * @brief   Sets the event which is posted each time every queued instruction and character has been executed, or
+ *          `EVENT_NONE` for no event.
+ */
+void lcdtext_set_idle_event( event_t event );
+
 /**
  * @fn      lcdtext_shift_left( lcdtext_t const * )
  * @brief   Shifts the entire display (including the cursor position) to the left.
@@ -224,19 +303,41 @@ void lcdtext_shift_left( lcdtext_t const * lcd );
  */
 void lcdtext_shift_right( lcdtext_t const * lcd );
 
+/**
+ * @fn      lcdtext_try_write( lcdtext_t const *, char const * )
+ * @brief   Writes the specified null-terminated string to the current cursor location, if it can be queued without
+ *          blocking.
+ * @returns `false` if there is not enough space in the queue, in which case nothing is written.
+ */
+bool lcdtext_try_write( lcdtext_t const * lcd, char const * str );
+
 /**
  * @fn      lcdtext_write( lcdtext_t const *, char const * )
  * @brief   Writes the specified null-terminated string to the current cursor location.
+ * @note    The string is copied, so this function returns as soon as its last character has been queued.
  */
 void lcdtext_write( lcdtext_t const * lcd, char const * str );
 
+/**
+ * @fn      lcdtext_write_char( lcdtext_t const *, char )
+ * @brief   Writes the specified character to the current cursor location.
+ */
+void lcdtext_write_char( lcdtext_t const * lcd, char chr );
+
 /**
  * @fn      lcdtext_write_delay( lcdtext_t const *, char const *, uint16_t )
  * @brief   Writes the specified null-terminated string to the current cursor location, pausing for the specified
  *          number of milliseconds between each character.
+ * @note    If the delay differs from that of any characters which are still queued, this waits for them to be written.
  */
 void lcdtext_write_delay( lcdtext_t const * lcd, char const * str, uint16_t delay_ms );
 
+/**
+ * @fn      lcdtext_wait( lcdtext_t const * )
+ * @brief   Waits until the specified LCD has executed every instruction and written every character.
+ */
+void lcdtext_wait( lcdtext_t const * lcd );
+
 /**
  * @fn      lcdtext_1602_write_lines( lcdtext_t const *, char const *, char const * )
  * @brief   Replaces the current content of the LCD1602 display with the specified strings.
@@ -0,0 +1,144 @@
+/**
+ * @file    prr.c
+ * @brief   Implementation for the power reduction register manager.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#include "zero/bit_ops.h"
+#include "zero/utility.h"
+
+#include "prr.h"
+
+/* -- Macros -- */
+
+// Helper macros to validate arguments
+#define validate_module( _module )  validate_enum( _module, PRR_MODULE_COUNT )
+
+// Module encoding used by the table below - ( register << 3 ) | bit
+#define MODULE( _reg, _bit )        ( ( uint8_t )( ( ( _reg ) << 3 ) | ( _bit ) ) )
+#define MODULE_REG( _module )       ( ( _module ) >> 3 )
+#define MODULE_BIT( _module )       ( ( _module ) & 0x07 )
+
+// Helper macro to get each power reduction register
+// (PRR0 and PRR1 are consecutive in the register map)
+#if defined( __AVR_ATmega328P__ )
+    #define PRR_REG( _reg )         ( ( & PRR )[ _reg ] )
+#elif defined( __AVR_ATmega2560__ )
+    #define PRR_REG( _reg )         ( ( & PRR0 )[ _reg ] )
+#else
+    #error "Unsupported device!"
+#endif
+
+/* -- Constants -- */
+
+// Register and bit for each module (stored in flash)
+static uint8_t const s_module_tbl[] PROGMEM =
+{
+    [ PRR_MODULE_ADC ]      = MODULE( 0, PRADC ),
+    [ PRR_MODULE_SPI ]      = MODULE( 0, PRSPI ),
+    [ PRR_MODULE_TWI ]      = MODULE( 0, PRTWI ),
+    [ PRR_MODULE_TIMER0 ]   = MODULE( 0, PRTIM0 ),
+    [ PRR_MODULE_TIMER1 ]   = MODULE( 0, PRTIM1 ),
+    [ PRR_MODULE_TIMER2 ]   = MODULE( 0, PRTIM2 ),
+#if defined( __AVR_ATmega2560__ )
+    [ PRR_MODULE_TIMER3 ]   = MODULE( 1, PRTIM3 ),
+    [ PRR_MODULE_TIMER4 ]   = MODULE( 1, PRTIM4 ),
+    [ PRR_MODULE_TIMER5 ]   = MODULE( 1, PRTIM5 ),
+#endif
+    [ PRR_MODULE_USART0 ]   = MODULE( 0, PRUSART0 ),
+#if defined( __AVR_ATmega2560__ )
+    [ PRR_MODULE_USART1 ]   = MODULE( 1, PRUSART1 ),
+    [ PRR_MODULE_USART2 ]   = MODULE( 1, PRUSART2 ),
+    [ PRR_MODULE_USART3 ]   = MODULE( 1, PRUSART3 ),
+#endif
+};
+
+// Ensure module table has an entry for every module
+_Static_assert( array_count( s_module_tbl ) == PRR_MODULE_COUNT, "s_module_tbl must have correct number of entries!" );
+
+/* -- Variables -- */
+
+// Number of acquisitions of each module
+static uint8_t s_counts[ PRR_MODULE_COUNT ];
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      power_down_all( void )
+ * @brief   Powers down every module during startup, before any driver has acquired them.
+ * @note    This is placed in the `.init8` section, which runs after the stack and data are initialized but before
+ *          constructors and `main()`. It is naked, so that it falls through to the next section.
+ */
+static void power_down_all( void ) __attribute__(( naked, used, section( ".init8" ) ));
+
+/* -- Procedures -- */
+
+void prr_acquire( prr_module_t module )
+{
+    validate_module( module );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+
+    assert( s_counts[ module ] != UINT8_MAX );
+    if( s_counts[ module ]++ == 0 )
+    {
+        uint8_t entry = pgm_read_byte( & s_module_tbl[ module ] );
+        clear_bit( PRR_REG( MODULE_REG( entry ) ), MODULE_BIT( entry ) );
+    }
+
+    if( int_en ) sei();
+
+} /* prr_acquire() */
+
+
+bool prr_is_powered( prr_module_t module )
+{
+    validate_module( module );
+
+    uint8_t entry = pgm_read_byte( & s_module_tbl[ module ] );
+    return( is_bit_clear( PRR_REG( MODULE_REG( entry ) ), MODULE_BIT( entry ) ) );
+
+} /* prr_is_powered() */
+
+
+void prr_release( prr_module_t module )
+{
+    validate_module( module );
+
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+
+    assert( s_counts[ module ] != 0 );
+    if( --s_counts[ module ] == 0 )
+    {
+        uint8_t entry = pgm_read_byte( & s_module_tbl[ module ] );
+        set_bit( PRR_REG( MODULE_REG( entry ) ), MODULE_BIT( entry ) );
+    }
+
+    if( int_en ) sei();
+
+} /* prr_release() */
+
+
+static void power_down_all( void )
+{
+    // Only straight-line code is allowed here - the mask for each register is computed at compile time
+    PRR_REG( 0 ) = bitmask7( PRADC, PRSPI, PRTWI, PRTIM0, PRTIM1, PRTIM2, PRUSART0 );
+#if defined( __AVR_ATmega2560__ )
+    PRR_REG( 1 ) = bitmask6( PRTIM3, PRTIM4, PRTIM5, PRUSART1, PRUSART2, PRUSART3 );
+#endif
+
+} /* power_down_all() */
@@ -0,0 +1,78 @@
+/**
+ * @file    prr.h
+ * @brief   Header for the power reduction register manager.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * This library owns the power reduction registers (`PRR` on the ATmega328P, `PRR0` and `PRR1` on the ATmega2560), which
+ * stop the clock to individual peripherals. Drivers acquire their peripheral before using it and release it once it is
+ * no longer needed - the peripheral is powered while any acquisition is held.
+ *
+ * Every peripheral listed here is powered down during startup (before `main()` is called), in any executable which
+ * links this library. Code which uses one of these peripherals directly, rather than through a driver, must therefore
+ * acquire it first. A peripheral's registers can't be read or written while it is powered down.
+ */
+
+#if !defined( PRR_PRR_H )
+#define PRR_PRR_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* -- Types -- */
+
+/**
+ * @typedef prr_module_t
+ * @brief   Enumeration of the peripherals controlled by the power reduction registers.
+ */
+typedef uint8_t prr_module_t;
+enum
+{
+    PRR_MODULE_ADC,                 /**< Analog to digital converter.                   */
+    PRR_MODULE_SPI,                 /**< Serial peripheral interface.                   */
+    PRR_MODULE_TWI,                 /**< Two-wire serial interface.                     */
+    PRR_MODULE_TIMER0,              /**< Timer/counter 0.                               */
+    PRR_MODULE_TIMER1,              /**< Timer/counter 1.                               */
+    PRR_MODULE_TIMER2,              /**< Timer/counter 2.                               */
+#if defined( __AVR_ATmega2560__ )
+    PRR_MODULE_TIMER3,              /**< Timer/counter 3.                               */
+    PRR_MODULE_TIMER4,              /**< Timer/counter 4.                               */
+    PRR_MODULE_TIMER5,              /**< Timer/counter 5.                               */
+#endif
+    PRR_MODULE_USART0,              /**< USART 0.                                       */
+#if defined( __AVR_ATmega2560__ )
+    PRR_MODULE_USART1,              /**< USART 1.                                       */
+    PRR_MODULE_USART2,              /**< USART 2.                                       */
+    PRR_MODULE_USART3,              /**< USART 3.                                       */
+#endif
+
+    PRR_MODULE_COUNT,               /**< Number of valid modules.                       */
+};
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      prr_acquire( prr_module_t )
+ * @brief   Powers up the specified peripheral, if it is not already powered.
+ * @note    Acquisitions are counted, so each call must be balanced by a call to `prr_release()`. This may be called
+ *          from interrupt handlers.
+ */
+void prr_acquire( prr_module_t module );
+
+/**
+ * @fn      prr_is_powered( prr_module_t )
+ * @brief   Returns `true` if the specified peripheral is currently powered.
+ */
+bool prr_is_powered( prr_module_t module );
+
+/**
+ * @fn      prr_release( prr_module_t )
+ * @brief   Releases an acquisition of the specified peripheral, and powers it down if it was the last one.
+ * @note    The peripheral stops immediately, so it must be idle (e.g., a USART must have finished transmitting).
+ */
+void prr_release( prr_module_t module );
+
+#endif /* !defined( PRR_PRR_H ) */
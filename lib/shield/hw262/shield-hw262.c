@@ -9,9 +9,12 @@
 /* -- Includes -- */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "debounce/debounce.h"
 #include "gpio/gpio.h"
+#include "zero/bit_ops.h"
 #include "zero/utility.h"
 
 #include "shield-hw262.h"
@@ -39,10 +42,21 @@ _Static_assert( array_count( s_led_pin_tbl ) == HW262_LED_COUNT, "LED pin table
 
 /* -- Macros -- */
 
+// Bitmask of all buttons in the debounce state
+#define BUTTON_MASK                     ( ( uint8_t )( bitmask( HW262_BUTTON_COUNT ) - 1 ) )
+
 // Helper macros to validate enums
 #define validate_button( _button )      validate_enum( _button, HW262_BUTTON_COUNT )
 #define validate_led( _led )            validate_enum( _led,    HW262_LED_COUNT )
 
+/* -- Variables -- */
+
+// Group containing all button pins, in button order
+static gpio_group_t s_button_group;
+
+// Debounce state for all buttons
+static debounce_t s_debounce;
+
 /* -- Procedures -- */
 
 bool hw262_button_get( hw262_button_t button )
@@ -52,6 +66,14 @@ bool hw262_button_get( hw262_button_t button )
 } /* hw262_button_get() */
 
 
+bool hw262_button_is_pressed( hw262_button_t button )
+{
+    validate_button( button );
+    return( is_bit_set( debounce_get_state( & s_debounce ), button ) );
+
+} /* hw262_button_is_pressed() */
+
+
 gpio_pin_t hw262_button_pin( hw262_button_t button )
 {
     validate_button( button );
@@ -60,12 +82,38 @@ gpio_pin_t hw262_button_pin( hw262_button_t button )
 } /* hw262_button_pin() */
 
 
+bool hw262_button_take_long_pressed( hw262_button_t button )
+{
+    validate_button( button );
+    return( debounce_take_long_pressed( & s_debounce, bitmask( button ) ) != 0 );
+
+} /* hw262_button_take_long_pressed() */
+
+
+bool hw262_button_take_pressed( hw262_button_t button )
+{
+    validate_button( button );
+    return( debounce_take_pressed( & s_debounce, bitmask( button ) ) != 0 );
+
+} /* hw262_button_take_pressed() */
+
+
+bool hw262_button_take_released( hw262_button_t button )
+{
+    validate_button( button );
+    return( debounce_take_released( & s_debounce, bitmask( button ) ) != 0 );
+
+} /* hw262_button_take_released() */
+
+
 void hw262_init( void )
 {
     // Configure GPIO inputs
     gpio_config_t input_config = { GPIO_DIR_IN, false };
     for( hw262_button_t button = 0; button < HW262_BUTTON_COUNT; button++ )
         gpio_set_config( hw262_button_pin( button ), & input_config );
+    gpio_group_init( & s_button_group, s_button_pin_tbl, HW262_BUTTON_COUNT );
+    debounce_init( & s_debounce, 0 );
 
     // Configure GPIO outputs
     gpio_config_t output_config = { GPIO_DIR_OUT, GPIO_STATE_HIGH };
@@ -88,3 +136,12 @@ void hw262_led_set( hw262_led_t led, bool on )
     gpio_set_state( hw262_led_pin( led ), on ? GPIO_STATE_LOW : GPIO_STATE_HIGH );
 
 } /* hw262_led_set() */
+
+
+void hw262_update( void )
+{
+    // Buttons are active low
+    if( debounce_tick( & s_debounce ) )
+        debounce_update( & s_debounce, ~gpio_group_read( & s_button_group ) & BUTTON_MASK );
+
+} /* hw262_update() */
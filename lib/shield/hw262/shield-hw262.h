@@ -11,6 +11,7 @@
 
 /* -- Includes -- */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "gpio/gpio.h"
@@ -50,17 +51,42 @@ enum
 
 /**
  * @fn      hw262_button_get( hw262_button_t )
- * @brief   Returns the state of the specified button.
+ * @brief   Returns the raw (not debounced) state of the specified button.
  * @returns `true` if the button is currently pressed.
  */
 bool hw262_button_get( hw262_button_t button );
 
+/**
+ * @fn      hw262_button_is_pressed( hw262_button_t )
+ * @brief   Returns the debounced state of the specified button.
+ * @returns `true` if the button is currently pressed.
+ */
+bool hw262_button_is_pressed( hw262_button_t button );
+
 /**
  * @fn      hw262_button_pin( hw262_button_t )
  * @brief   Returns the GPIO pin associated with the specified button.
  */
 gpio_pin_t hw262_button_pin( hw262_button_t button );
 
+/**
+ * @fn      hw262_button_take_long_pressed( hw262_button_t )
+ * @brief   Returns `true` if the specified button has been held down for a long press since the last call.
+ */
+bool hw262_button_take_long_pressed( hw262_button_t button );
+
+/**
+ * @fn      hw262_button_take_pressed( hw262_button_t )
+ * @brief   Returns `true` if the specified button has been pressed since the last call.
+ */
+bool hw262_button_take_pressed( hw262_button_t button );
+
+/**
+ * @fn      hw262_button_take_released( hw262_button_t )
+ * @brief   Returns `true` if the specified button has been released since the last call.
+ */
+bool hw262_button_take_released( hw262_button_t button );
+
 /**
  * @fn      hw262_init( void )
  * @brief   Initializes the HW262 module.
@@ -79,4 +105,11 @@ gpio_pin_t hw262_led_pin( hw262_led_t led );
  */
 void hw262_led_set( hw262_led_t led, bool on );
 
+/**
+ * @fn      hw262_update( void )
+ * @brief   Advances debouncing of the buttons by one tick.
+ * @note    This should be called once per 1 ms system tick.
+ */
+void hw262_update( void );
+
 #endif /* !defined( SHIELD_HW262_SHIELD_HW262_H ) */
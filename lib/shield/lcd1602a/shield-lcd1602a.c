@@ -12,17 +12,59 @@
 #include <stdint.h>
 
 #include "adc/adc.h"
+#include "debounce/debounce.h"
 #include "lcdtext/lcdtext.h"
+#include "zero/bit_ops.h"
+#include "zero/utility.h"
 
 #include "shield-lcd1602a.h"
 
+/* -- Macros -- */
+
+// Helper macros to validate enums
+#define validate_button( _button )      validate_enum( _button, SHIELD_LCD1602A_BUTTON_COUNT )
+
 /* -- Variables -- */
 
+static debounce_t s_debounce;
+
 static lcdtext_t lcd_struct;
 #define lcd ( ( lcdtext_t const * ) & lcd_struct )
 
 /* -- Procedures -- */
 
+bool shield_lcd1602a_button_is_pressed( shield_lcd1602a_button_t button )
+{
+    validate_button( button );
+    return( is_bit_set( debounce_get_state( & s_debounce ), button ) );
+
+} /* shield_lcd1602a_button_is_pressed() */
+
+
+bool shield_lcd1602a_button_take_long_pressed( shield_lcd1602a_button_t button )
+{
+    validate_button( button );
+    return( debounce_take_long_pressed( & s_debounce, bitmask( button ) ) != 0 );
+
+} /* shield_lcd1602a_button_take_long_pressed() */
+
+
+bool shield_lcd1602a_button_take_pressed( shield_lcd1602a_button_t button )
+{
+    validate_button( button );
+    return( debounce_take_pressed( & s_debounce, bitmask( button ) ) != 0 );
+
+} /* shield_lcd1602a_button_take_pressed() */
+
+
+bool shield_lcd1602a_button_take_released( shield_lcd1602a_button_t button )
+{
+    validate_button( button );
+    return( debounce_take_released( & s_debounce, bitmask( button ) ) != 0 );
+
+} /* shield_lcd1602a_button_take_released() */
+
+
 shield_lcd1602a_button_t shield_lcd1602a_get_button( void )
 {
     adc_set_channel( ADC_CHANNEL_ARDUINO_A0 );
@@ -64,13 +106,16 @@ void shield_lcd1602a_init( void )
     lcd_struct.pins.d7              = GPIO_PIN_ARDUINO_D07;
 
     // Init LCD
-    lcdtext_init( lcd );
+    lcdtext_init( & lcd_struct );
 
     // Initialize ADC
     adc_init();
     adc_set_vref( ADC_VREF_AVCC );
     adc_set_enabled( true );
 
+    // Initialize button debouncing
+    debounce_init( & s_debounce, 0 );
+
 } /* shield_lcd1602a_init() */
 
 
@@ -79,3 +124,15 @@ lcdtext_t const * shield_lcd1602a_lcd( void )
     return( lcd );
 
 } /* shield_lcd1602a_lcd() */
+
+
+void shield_lcd1602a_update( void )
+{
+    // Only one button can be detected at a time through the resistor ladder
+    if( debounce_tick( & s_debounce ) )
+    {
+        shield_lcd1602a_button_t button = shield_lcd1602a_get_button();
+        debounce_update( & s_debounce, button == SHIELD_LCD1602A_BUTTON_NONE ? 0 : bitmask( button ) );
+    }
+
+} /* shield_lcd1602a_update() */
@@ -11,6 +11,7 @@
 
 /* -- Includes -- */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "lcdtext/lcdtext.h"
@@ -38,9 +39,34 @@ enum
 
 /* -- Procedure Prototypes -- */
 
+/**
+ * @fn      shield_lcd1602a_button_is_pressed( shield_lcd1602a_button_t )
+ * @brief   Returns `true` if the specified button is pressed, after debouncing.
+ */
+bool shield_lcd1602a_button_is_pressed( shield_lcd1602a_button_t button );
+
+/**
+ * @fn      shield_lcd1602a_button_take_long_pressed( shield_lcd1602a_button_t )
+ * @brief   Returns `true` if the specified button has been held down for a long press since the last call.
+ */
+bool shield_lcd1602a_button_take_long_pressed( shield_lcd1602a_button_t button );
+
+/**
+ * @fn      shield_lcd1602a_button_take_pressed( shield_lcd1602a_button_t )
+ * @brief   Returns `true` if the specified button has been pressed since the last call.
+ */
+bool shield_lcd1602a_button_take_pressed( shield_lcd1602a_button_t button );
+
+/**
+ * @fn      shield_lcd1602a_button_take_released( shield_lcd1602a_button_t )
+ * @brief   Returns `true` if the specified button has been released since the last call.
+ */
+bool shield_lcd1602a_button_take_released( shield_lcd1602a_button_t button );
+
 /**
  * @fn      shield_lcd1602a_get_button( void )
  * @brief   Returns the currently pressed button, if any.
+ * @note    This is the raw (not debounced) state of the buttons.
  */
 shield_lcd1602a_button_t shield_lcd1602a_get_button( void );
 
@@ -56,4 +82,11 @@ void shield_lcd1602a_init( void );
  */
 lcdtext_t const * shield_lcd1602a_lcd( void );
 
+/**
+ * @fn      shield_lcd1602a_update( void )
+ * @brief   Advances debouncing of the buttons by one tick.
+ * @note    This should be called once per 1 ms system tick. An ADC conversion is performed on each debounce sample.
+ */
+void shield_lcd1602a_update( void );
+
 #endif /* !defined( SHIELDS_LCD1602A_SHIELD_LCD1602A_H ) */
@@ -0,0 +1,271 @@
+/**
+ * @file    swtimer.c
+ * @brief   Implementation for the software timer library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "swtimer.h"
+
+/* -- Macros -- */
+
+// Ensure configuration is valid
+_Static_assert( SWTIMER_WHEEL_BITS >= 1 && SWTIMER_WHEEL_BITS <= 8,
+                "SWTIMER_WHEEL_BITS must be between 1 and 8!" );
+_Static_assert( SWTIMER_WHEEL_LEVELS >= 1 && SWTIMER_WHEEL_BITS * SWTIMER_WHEEL_LEVELS < 32,
+                "The timing wheel must span fewer than 32 bits!" );
+
+// Helper macros to locate the wheel slot for a tick
+#define SLOT_MASK                   ( SWTIMER_WHEEL_SLOTS - 1 )
+#define LEVEL_SHIFT( _level )       ( SWTIMER_WHEEL_BITS * ( _level ) )
+#define SLOT_INDEX( _tick, _level ) ( ( uint8_t )( ( _tick ) >> LEVEL_SHIFT( _level ) ) & SLOT_MASK )
+
+/* -- Variables -- */
+
+// List of timers filed into each slot of each level of the wheel
+static swtimer_t*   s_wheel[ SWTIMER_WHEEL_LEVELS ][ SWTIMER_WHEEL_SLOTS ];
+
+// Most recent tick serviced by the wheel
+static uint32_t     s_now;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      cascade( uint8_t )
+ * @brief   Re-files every timer in the current slot of the specified level into the lower levels of the wheel.
+ */
+static void cascade( uint8_t level );
+
+/**
+ * @fn      expire( void )
+ * @brief   Invokes the callback of every timer in the current slot of the lowest level of the wheel.
+ */
+static void expire( void );
+
+/**
+ * @fn      file( swtimer_t* )
+ * @brief   Adds the specified timer to the wheel slot which is serviced next before its expiry.
+ */
+static void file( swtimer_t* timer );
+
+/**
+ * @fn      step( void )
+ * @brief   Advances the wheel by a single tick.
+ */
+static void step( void );
+
+/**
+ * @fn      unlink( swtimer_t* )
+ * @brief   Removes the specified timer from the list it is in.
+ */
+static void unlink( swtimer_t* timer );
+
+/* -- Procedures -- */
+
+void swtimer_advance( uint32_t now )
+{
+    while( ( int32_t )( now - s_now ) > 0 )
+    {
+        // After a long gap (e.g., a tickless sleep), skip straight over the ticks with nothing to service
+        uint32_t next;
+        if( now - s_now > 1 )
+        {
+            if( ! swtimer_get_next_expiry( & next ) || ( int32_t )( next - now ) > 0 )
+            {
+                s_now = now;
+                break;
+            }
+            s_now = next - 1;
+        }
+
+        step();
+    }
+
+} /* swtimer_advance() */
+
+
+bool swtimer_get_next_expiry( uint32_t* tick )
+{
+    bool found = false;
+    uint32_t best = 0;
+
+    // Find the first occupied slot in each level - the tick on which it is serviced is the first tick on which each
+    // level may have work to do
+    for( uint8_t level = 0; level < SWTIMER_WHEEL_LEVELS; level++ )
+    {
+        uint8_t index = SLOT_INDEX( s_now, level );
+        for( uint8_t i = 1; i <= SWTIMER_WHEEL_SLOTS; i++ )
+        {
+            if( s_wheel[ level ][ ( index + i ) & SLOT_MASK ] == NULL )
+                continue;
+
+            uint32_t delta = ( ( ( s_now >> LEVEL_SHIFT( level ) ) + i ) << LEVEL_SHIFT( level ) ) - s_now;
+            if( ! found || delta < best )
+                best = delta;
+            found = true;
+            break;
+        }
+    }
+
+    if( found )
+        * tick = s_now + best;
+
+    return( found );
+
+} /* swtimer_get_next_expiry() */
+
+
+void swtimer_init( uint32_t now )
+{
+    for( uint8_t level = 0; level < SWTIMER_WHEEL_LEVELS; level++ )
+        for( uint8_t slot = 0; slot < SWTIMER_WHEEL_SLOTS; slot++ )
+            s_wheel[ level ][ slot ] = NULL;
+
+    s_now = now;
+
+} /* swtimer_init() */
+
+
+bool swtimer_is_active( swtimer_t const* timer )
+{
+    return( timer->pprev != NULL );
+
+} /* swtimer_is_active() */
+
+
+void swtimer_setup( swtimer_t* timer )
+{
+    timer->next = NULL;
+    timer->pprev = NULL;
+
+} /* swtimer_setup() */
+
+
+void swtimer_start( swtimer_t* timer, uint32_t delay, uint32_t period, swtimer_callback_t callback, void* arg )
+{
+    swtimer_stop( timer );
+
+    timer->expiry   = s_now + ( delay > 0 ? delay : 1 );
+    timer->period   = period;
+    timer->callback = callback;
+    timer->arg      = arg;
+    file( timer );
+
+} /* swtimer_start() */
+
+
+void swtimer_stop( swtimer_t* timer )
+{
+    if( timer->pprev != NULL )
+        unlink( timer );
+
+} /* swtimer_stop() */
+
+
+static void cascade( uint8_t level )
+{
+    swtimer_t** head = & s_wheel[ level ][ SLOT_INDEX( s_now, level ) ];
+    swtimer_t* list = * head;
+    * head = NULL;
+
+    // Every timer in the slot is now close enough to its expiry to be filed into a lower level
+    while( list != NULL )
+    {
+        swtimer_t* timer = list;
+        list = timer->next;
+        file( timer );
+    }
+
+} /* cascade() */
+
+
+static void expire( void )
+{
+    swtimer_t** head = & s_wheel[ 0 ][ SLOT_INDEX( s_now, 0 ) ];
+    swtimer_t* pending = * head;
+    if( pending == NULL )
+        return;
+
+    // Move the slot to a local list, so that callbacks may safely stop timers which have not been serviced yet
+    * head = NULL;
+    pending->pprev = & pending;
+
+    while( pending != NULL )
+    {
+        swtimer_t* timer = pending;
+        unlink( timer );
+
+        // Periodic timers are reloaded before the callback runs, so that the callback is able to stop them
+        if( timer->period != 0 )
+        {
+            timer->expiry += timer->period;
+            file( timer );
+        }
+
+        timer->callback( timer, timer->arg );
+    }
+
+} /* expire() */
+
+
+static void file( swtimer_t* timer )
+{
+    // A timer which is due on the current tick is filed into the current slot of the lowest level - this only happens
+    // while a tick is being serviced, before that slot has expired
+    uint32_t delta = timer->expiry - s_now;
+    if( ( int32_t )delta < 0 )
+        delta = 0;
+
+    // Timers beyond the span of the wheel are filed as far out as possible, and re-filed when that slot is serviced
+    if( ( delta >> LEVEL_SHIFT( SWTIMER_WHEEL_LEVELS ) ) != 0 )
+        delta = ( ( uint32_t )1 << LEVEL_SHIFT( SWTIMER_WHEEL_LEVELS ) ) - 1;
+
+    // Use the lowest level whose span covers the delay - the slot is always serviced on or before the expiry tick
+    uint8_t level = 0;
+    while( level < SWTIMER_WHEEL_LEVELS - 1 && ( delta >> LEVEL_SHIFT( level + 1 ) ) != 0 )
+        level++;
+
+    swtimer_t** head = & s_wheel[ level ][ SLOT_INDEX( s_now + delta, level ) ];
+    timer->next = * head;
+    timer->pprev = head;
+    if( * head != NULL )
+        ( * head )->pprev = & timer->next;
+    * head = timer;
+
+} /* file() */
+
+
+static void step( void )
+{
+    s_now++;
+
+    // Each time a level wraps around, the next slot of the level above it is moved down
+    for( uint8_t level = 1; level < SWTIMER_WHEEL_LEVELS; level++ )
+    {
+        if( SLOT_INDEX( s_now, level - 1 ) != 0 )
+            break;
+        cascade( level );
+    }
+
+    expire();
+
+} /* step() */
+
+
+static void unlink( swtimer_t* timer )
+{
+    * timer->pprev = timer->next;
+    if( timer->next != NULL )
+        timer->next->pprev = timer->pprev;
+
+    timer->next = NULL;
+    timer->pprev = NULL;
+
+} /* unlink() */
@@ -0,0 +1,146 @@
+/**
+ * @file    swtimer.h
+ * @brief   Header for the software timer library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * This library provides one-shot and periodic software timers on top of a free-running 1 ms tick (i.e., the value of
+ * `event_tick()`). Timers are kept in a hierarchical timing wheel - each level has `SWTIMER_WHEEL_SLOTS` slots, and
+ * each slot covers `SWTIMER_WHEEL_SLOTS` times as many ticks as a slot on the level below it. Starting, stopping, and
+ * expiring a timer are all constant time operations, and a tick on which no slot needs servicing costs the same
+ * regardless of how many timers are running.
+ *
+ * Timers are owned by the caller, and must remain valid until they expire (one-shot timers) or are stopped. Each timer
+ * must be initialized by `swtimer_setup()` (or be zero-initialized, as a static timer is) before it is first started or
+ * stopped, since a timer which appears to be running is unlinked from the wheel when it is restarted. All of the
+ * procedures in this library must be called from the main loop only - they must not be called from interrupt context.
+ */
+
+#if !defined( SWTIMER_SWTIMER_H )
+#define SWTIMER_SWTIMER_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* -- Constants -- */
+
+/**
+ * @def     SWTIMER_WHEEL_BITS
+ * @brief   Number of bits of the tick count covered by each level of the timing wheel.
+ */
+#if !defined( SWTIMER_WHEEL_BITS )
+    #define SWTIMER_WHEEL_BITS      4
+#endif
+
+/**
+ * @def     SWTIMER_WHEEL_LEVELS
+ * @brief   Number of levels in the timing wheel.
+ * @note    With the default settings, the wheel spans 2^24 ticks (about 4.6 hours at 1 ms per tick). Timers with longer
+ *          delays are still supported, but are re-filed each time the top level of the wheel wraps.
+ */
+#if !defined( SWTIMER_WHEEL_LEVELS )
+    #define SWTIMER_WHEEL_LEVELS    6
+#endif
+
+/**
+ * @def     SWTIMER_WHEEL_SLOTS
+ * @brief   Number of slots in each level of the timing wheel.
+ */
+#define SWTIMER_WHEEL_SLOTS         ( 1 << SWTIMER_WHEEL_BITS )
+
+/* -- Types -- */
+
+/**
+ * @typedef swtimer_t
+ * @brief   Forward declaration of the software timer struct.
+ */
+typedef struct swtimer_s swtimer_t;
+
+/**
+ * @typedef swtimer_callback_t
+ * @brief   Callback invoked when a software timer expires.
+ * @note    The callback may freely start or stop any timer, including the one which expired.
+ */
+typedef void ( * swtimer_callback_t )( swtimer_t* timer, void* arg );
+
+/**
+ * @struct  swtimer_s
+ * @brief   Struct containing the state of a single software timer.
+ * @note    The contents of this struct should only be accessed through the procedures below.
+ */
+struct swtimer_s
+{
+    swtimer_t*          next;       /**< Next timer in the same wheel slot.             */
+    swtimer_t**         pprev;      /**< Link which points to this timer, or `NULL`.    */
+    uint32_t            expiry;     /**< Tick on which the timer expires.               */
+    uint32_t            period;     /**< Reload period in ticks, or 0 for one-shot.     */
+    swtimer_callback_t  callback;   /**< Callback to invoke on expiry.                  */
+    void*               arg;        /**< Argument to pass to the callback.              */
+};
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      swtimer_advance( uint32_t )
+ * @brief   Advances the timing wheel to the specified tick, invoking the callback of every timer which expires.
+ * @note    If more than one tick has elapsed since the last call (e.g., after a tickless sleep), each tick in between
+ *          is serviced in turn, so that no timer is skipped.
+ */
+void swtimer_advance( uint32_t now );
+
+/**
+ * @fn      swtimer_get_next_expiry( uint32_t* )
+ * @brief   Gets the next tick on which `swtimer_advance()` may have work to do.
+ * @returns `false` if no timers are running, in which case `tick` is not modified.
+ * @note    The returned tick is never later than the earliest expiry, but may be earlier when a timer is being moved
+ *          down the wheel. It is intended as a wakeup hint for tickless operation (i.e., for `event_schedule_tick()`).
+ */
+bool swtimer_get_next_expiry( uint32_t* tick );
+
+/**
+ * @fn      swtimer_init( uint32_t )
+ * @brief   Initializes the software timer library, with the wheel starting at the specified tick.
+ */
+void swtimer_init( uint32_t now );
+
+/**
+ * @fn      swtimer_is_active( swtimer_t const* )
+ * @brief   Returns `true` if the specified timer is running.
+ */
+bool swtimer_is_active( swtimer_t const* timer );
+
+/**
+ * @fn      swtimer_setup( swtimer_t* )
+ * @brief   Initializes the specified timer in the stopped state.
+ * @note    This must be called before the timer is first used, unless it is zero-initialized, and must not be called
+ *          while the timer is running.
+ */
+void swtimer_setup( swtimer_t* timer );
+
+/**
+ * @fn      swtimer_start( swtimer_t*, uint32_t, uint32_t, swtimer_callback_t, void* )
+ * @brief   Starts (or restarts) the specified timer.
+ * @param   timer
+ *          The timer to start. If the timer is already running, it is stopped first.
+ * @param   delay
+ *          The number of ticks until the timer first expires, measured from the tick most recently passed to
+ *          `swtimer_advance()`. Values less than 1 are treated as 1.
+ * @param   period
+ *          The number of ticks between subsequent expiries, or 0 for a one-shot timer.
+ * @param   callback
+ *          The callback to invoke each time the timer expires.
+ * @param   arg
+ *          An arbitrary argument to pass to `callback`.
+ */
+void swtimer_start( swtimer_t* timer, uint32_t delay, uint32_t period, swtimer_callback_t callback, void* arg );
+
+/**
+ * @fn      swtimer_stop( swtimer_t* )
+ * @brief   Stops the specified timer. Has no effect if the timer is not running.
+ */
+void swtimer_stop( swtimer_t* timer );
+
+#endif /* !defined( SWTIMER_SWTIMER_H ) */
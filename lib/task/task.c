@@ -0,0 +1,107 @@
+/**
+ * @file    task.c
+ * @brief   Implementation for the cooperative task scheduler library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "event/event.h"
+
+#include "task.h"
+
+/* -- Variables -- */
+
+// List of running tasks
+static task_t*  s_tasks = NULL;
+
+// Event for which the scheduler is running
+static event_t  s_event = EVENT_NONE;
+
+/* -- Procedures -- */
+
+bool task_deadline_passed( task_t* task )
+{
+    if( ( int32_t )( event_tick() - task->deadline ) < 0 )
+        return( false );
+
+    task->delayed = false;
+    return( true );
+
+} /* task_deadline_passed() */
+
+
+event_t task_get_event( void )
+{
+    return( s_event );
+
+} /* task_get_event() */
+
+
+void task_handle_event( event_t event )
+{
+    bool yielded = false;
+    bool delayed = false;
+    uint32_t deadline = 0;
+
+    s_event = event;
+    for( task_t** link = & s_tasks; * link != NULL; )
+    {
+        task_t* task = * link;
+        task_state_t state = task->fn( task );
+        if( state == TASK_EXITED )
+        {
+            // Unlink the task - it may be started again afterwards
+            * link = task->next;
+            task->next = NULL;
+            continue;
+        }
+
+        yielded |= ( state == TASK_YIELDED );
+
+        // Track the earliest delay, since the event manager only keeps a single deadline at a time
+        if( task->delayed && ( ! delayed || ( int32_t )( task->deadline - deadline ) < 0 ) )
+        {
+            deadline = task->deadline;
+            delayed = true;
+        }
+
+        link = & task->next;
+    }
+    s_event = EVENT_NONE;
+
+    if( yielded )
+        event_schedule_tick( event_tick() );
+    else if( delayed )
+        event_schedule_tick( deadline );
+
+} /* task_handle_event() */
+
+
+void task_set_deadline( task_t* task, uint32_t deadline )
+{
+    task->deadline = deadline;
+    task->delayed = true;
+
+} /* task_set_deadline() */
+
+
+void task_start( task_t* task, task_fn_t fn )
+{
+    task->fn = fn;
+    task->lc = 0;
+    task->delayed = false;
+
+    task->next = s_tasks;
+    s_tasks = task;
+
+    // Run the new task as soon as possible
+    event_schedule_tick( event_tick() );
+
+} /* task_start() */
@@ -0,0 +1,213 @@
+/**
+ * @file    task.h
+ * @brief   Header for the cooperative task scheduler library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * This library runs any number of cooperative, stackless tasks (in the style of protothreads) on top of the event
+ * manager. A task is an ordinary function which is called again each time the scheduler runs, and which resumes from
+ * the point where it last blocked - each task needs only a `task_t` struct, and no stack or heap of its own.
+ *
+ * A task function has the following form:
+ *
+ * ```
+ * static task_state_t blink_task( task_t* task )
+ * {
+ *     TASK_BEGIN( task );
+ *     while( true )
+ *     {
+ *         gpio_toggle_state( LED_PIN );
+ *         TASK_DELAY( task, 500 );
+ *     }
+ *     TASK_END( task );
+ * }
+ * ```
+ *
+ * The scheduler runs every task once each time `task_handle_event()` is called, which should be the handler for
+ * `EVENT_TICK` and for every event a task may await. Blocked tasks cost a single call per event in which they check
+ * their wait condition.
+ *
+ * Because a task returns each time it blocks, its local variables are not preserved across a blocking macro - state
+ * which must persist should be `static`, or kept in a struct which embeds the `task_t`. The blocking macros are
+ * implemented with `case` labels, so they can't be used inside a `switch` statement in the task function, and no more
+ * than one may appear on a single line.
+ */
+
+#if !defined( TASK_TASK_H )
+#define TASK_TASK_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "event/event.h"
+
+/* -- Macros -- */
+
+/**
+ * @def     TASK_BEGIN
+ * @brief   Marks the start of a task function's body.
+ */
+#define TASK_BEGIN( _task )                                                     \
+    switch( ( _task )->lc )                                                     \
+    {                                                                           \
+    case 0:
+
+/**
+ * @def     TASK_END
+ * @brief   Marks the end of a task function's body. A task which reaches this point exits.
+ */
+#define TASK_END( _task )                                                       \
+    }                                                                           \
+    ( _task )->lc = 0;                                                          \
+    return( TASK_EXITED )
+
+/**
+ * @def     TASK_EXIT
+ * @brief   Exits the task immediately.
+ */
+#define TASK_EXIT( _task )                                                      \
+    do                                                                          \
+    {                                                                           \
+        ( _task )->lc = 0;                                                      \
+        return( TASK_EXITED );                                                  \
+    }                                                                           \
+    while( 0 )
+
+/**
+ * @def     TASK_YIELD
+ * @brief   Blocks the task until the next time the scheduler runs, allowing every other task to run first.
+ */
+#define TASK_YIELD( _task )                                                     \
+    do                                                                          \
+    {                                                                           \
+        ( _task )->lc = __LINE__;                                               \
+        return( TASK_YIELDED );                                                 \
+    case __LINE__:;                                                             \
+    }                                                                           \
+    while( 0 )
+
+/**
+ * @def     TASK_WAIT_UNTIL
+ * @brief   Blocks the task until the specified condition is true.
+ * @note    The condition is evaluated immediately, and then each time the scheduler runs (e.g., it may test whether
+ *          USART data has been received, as long as the RX interrupt posts an event which runs the scheduler).
+ */
+#define TASK_WAIT_UNTIL( _task, _cond )                                         \
+    do                                                                          \
+    {                                                                           \
+        ( _task )->lc = __LINE__;                                               \
+    case __LINE__:                                                              \
+        if( ! ( _cond ) )                                                       \
+            return( TASK_WAITING );                                             \
+    }                                                                           \
+    while( 0 )
+
+/**
+ * @def     TASK_AWAIT_EVENT
+ * @brief   Blocks the task until the next time the scheduler runs for the specified event.
+ */
+#define TASK_AWAIT_EVENT( _task, _event )                                       \
+    do                                                                          \
+    {                                                                           \
+        ( _task )->lc = __LINE__;                                               \
+        return( TASK_WAITING );                                                 \
+    case __LINE__:                                                              \
+        if( task_get_event() != ( _event ) )                                    \
+            return( TASK_WAITING );                                             \
+    }                                                                           \
+    while( 0 )
+
+/**
+ * @def     TASK_DELAY
+ * @brief   Blocks the task for at least the specified number of milliseconds.
+ */
+#define TASK_DELAY( _task, _ms )                                                \
+    do                                                                          \
+    {                                                                           \
+        task_set_deadline( ( _task ), event_tick() + ( _ms ) );                 \
+        TASK_WAIT_UNTIL( ( _task ), task_deadline_passed( _task ) );            \
+    }                                                                           \
+    while( 0 )
+
+/* -- Types -- */
+
+/**
+ * @typedef task_state_t
+ * @brief   Enumeration of the states returned by a task function.
+ */
+typedef uint8_t task_state_t;
+enum
+{
+    TASK_WAITING,                   /**< Task is blocked on a condition.                */
+    TASK_YIELDED,                   /**< Task is ready to run again immediately.        */
+    TASK_EXITED,                    /**< Task has finished.                             */
+};
+
+/**
+ * @typedef task_t
+ * @brief   Forward declaration of the task struct.
+ */
+typedef struct task_s task_t;
+
+/**
+ * @typedef task_fn_t
+ * @brief   Task function, which is resumed each time the scheduler runs.
+ */
+typedef task_state_t ( * task_fn_t )( task_t* task );
+
+/**
+ * @struct  task_s
+ * @brief   Struct containing the state of a single task.
+ * @note    The contents of this struct should only be accessed through the procedures and macros in this file.
+ */
+struct task_s
+{
+    task_t*             next;       /**< Next task in the scheduler's list.             */
+    task_fn_t           fn;         /**< Task function.                                 */
+    uint16_t            lc;         /**< Line at which the task resumes, or 0.          */
+    uint32_t            deadline;   /**< Tick at which the current delay ends.          */
+    bool                delayed;    /**< Set if `deadline` is valid.                    */
+};
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      task_deadline_passed( task_t* )
+ * @brief   Returns `true` if the specified task's delay has ended, and clears the delay if so.
+ * @note    This is used by `TASK_DELAY()`.
+ */
+bool task_deadline_passed( task_t* task );
+
+/**
+ * @fn      task_get_event( void )
+ * @brief   Returns the event for which the scheduler is running, or `EVENT_NONE` if it is not running.
+ */
+event_t task_get_event( void );
+
+/**
+ * @fn      task_handle_event( event_t )
+ * @brief   Runs every task once, and removes any tasks which exit.
+ * @note    This is an `event_handler_t`, and should be used as the handler for `EVENT_TICK` and for each event which a
+ *          task may await. If any task yields, an immediate `EVENT_TICK` is requested so that it runs again before the
+ *          processor sleeps (in `EVENT_MODE_PERIODIC`, it runs on the next tick instead).
+ */
+void task_handle_event( event_t event );
+
+/**
+ * @fn      task_set_deadline( task_t*, uint32_t )
+ * @brief   Sets the tick at which the specified task's delay ends.
+ * @note    This is used by `TASK_DELAY()`.
+ */
+void task_set_deadline( task_t* task, uint32_t deadline );
+
+/**
+ * @fn      task_start( task_t*, task_fn_t )
+ * @brief   Adds the specified task to the scheduler, to run from the start of `fn` the next time the scheduler runs.
+ * @note    The task must not already be running, and must remain valid until it exits.
+ */
+void task_start( task_t* task, task_fn_t fn );
+
+#endif /* !defined( TASK_TASK_H ) */
@@ -0,0 +1,282 @@
+/**
+ * @file    usart-buf.c
+ * @brief   Implementation for the interrupt-driven, buffered mode of the USART driver library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+/* -- Includes -- */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "zero/bit_ops.h"
+#include "zero/pinout.h"
+#include "zero/register.h"
+#include "zero/utility.h"
+
+#include "usart.h"
+#include "usart-buf.h"
+
+/* -- Macros -- */
+
+// Ensure buffer sizes are usable with 8-bit free-running indices
+_Static_assert( USART_BUF_RX_SIZE <= 128 && ( USART_BUF_RX_SIZE & ( USART_BUF_RX_SIZE - 1 ) ) == 0,
+                "USART_BUF_RX_SIZE must be a power of two no larger than 128!" );
+_Static_assert( USART_BUF_TX_SIZE <= 128 && ( USART_BUF_TX_SIZE & ( USART_BUF_TX_SIZE - 1 ) ) == 0,
+                "USART_BUF_TX_SIZE must be a power of two no larger than 128!" );
+
+// Masks to convert free-running indices into buffer offsets
+#define RX_MASK                     ( USART_BUF_RX_SIZE - 1 )
+#define TX_MASK                     ( USART_BUF_TX_SIZE - 1 )
+
+// The ATmega328P's single USART uses vector names without a port number
+#if !defined( USART0_RX_vect ) && defined( USART_RX_vect )
+    #define USART0_RX_vect          USART_RX_vect
+    #define USART0_UDRE_vect        USART_UDRE_vect
+#endif
+
+// Helper macro to define the interrupt handlers for a port
+// (the registers are named directly so that each handler compiles down to fixed addresses)
+#define DEFINE_ISRS( _port )                                                    \
+    _DEFINE_ISRS( _port )
+#define _DEFINE_ISRS( _port )                                                   \
+    ISR( USART ## _port ## _RX_vect )                                           \
+    {                                                                           \
+        handle_rx( _port, UDR ## _port );                                       \
+    }                                                                           \
+    ISR( USART ## _port ## _UDRE_vect )                                         \
+    {                                                                           \
+        if( ! handle_udre( _port, REGISTER_ADDR( UDR ## _port ) ) )             \
+            clear_bit( UCSR ## _port ## B, UDRIE ## _port );                    \
+    }
+
+// Helper macros to validate arguments
+#define validate_port( _port )      validate_enum( _port, USART_PORT_COUNT )
+
+/* -- Variables -- */
+
+// Ring buffer state for each USART port
+// - RX: the head is only written by the ISR, and the tail is only written by the main loop
+// - TX: the head is only written by the main loop, and the tail is only written by the ISR
+static struct
+{
+    uint8_t                     rx_buf[ USART_BUF_RX_SIZE ];
+    uint8_t volatile            rx_head;
+    uint8_t volatile            rx_tail;
+    bool volatile               rx_overflow;
+    usart_buf_rx_callback_t     rx_callback;
+    uint8_t                     tx_buf[ USART_BUF_TX_SIZE ];
+    uint8_t volatile            tx_head;
+    uint8_t volatile            tx_tail;
+}
+s_port_tbl[ USART_PORT_COUNT ];
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      handle_rx( usart_port_t, uint8_t )
+ * @brief   Handles an RX complete interrupt for the specified port.
+ */
+static inline __attribute__(( always_inline )) void handle_rx( usart_port_t port, uint8_t byte );
+
+/**
+ * @fn      handle_udre( usart_port_t, register_t )
+ * @brief   Handles a data register empty interrupt for the specified port.
+ * @returns `false` if the TX buffer is empty and the interrupt should be disabled.
+ */
+static inline __attribute__(( always_inline )) bool handle_udre( usart_port_t port, register_t udr );
+
+/* -- Procedures -- */
+
+uint8_t usart_buf_get_rx_count( usart_port_t port )
+{
+    validate_port( port );
+    return( ( uint8_t )( s_port_tbl[ port ].rx_head - s_port_tbl[ port ].rx_tail ) );
+
+} /* usart_buf_get_rx_count() */
+
+
+bool usart_buf_get_rx_overflow( usart_port_t port )
+{
+    validate_port( port );
+
+    // Flag is only ever set by the ISR, so a single-byte read and clear is safe
+    bool overflow = s_port_tbl[ port ].rx_overflow;
+    if( overflow )
+        s_port_tbl[ port ].rx_overflow = false;
+
+    return( overflow );
+
+} /* usart_buf_get_rx_overflow() */
+
+
+uint8_t usart_buf_get_tx_free( usart_port_t port )
+{
+    validate_port( port );
+    return( ( uint8_t )( USART_BUF_TX_SIZE - ( uint8_t )( s_port_tbl[ port ].tx_head - s_port_tbl[ port ].tx_tail ) ) );
+
+} /* usart_buf_get_tx_free() */
+
+
+bool usart_buf_get_tx_idle( usart_port_t port )
+{
+    validate_port( port );
+    return( s_port_tbl[ port ].tx_head == s_port_tbl[ port ].tx_tail );
+
+} /* usart_buf_get_tx_idle() */
+
+
+void usart_buf_init( usart_port_t port )
+{
+    validate_port( port );
+
+    // Quiesce the interrupts while the indices are reset
+    usart_set_rx_complete_interrupt_enabled( port, false );
+    usart_set_data_empty_interrupt_enabled( port, false );
+
+    s_port_tbl[ port ].rx_head      = 0;
+    s_port_tbl[ port ].rx_tail      = 0;
+    s_port_tbl[ port ].rx_overflow  = false;
+    s_port_tbl[ port ].tx_head      = 0;
+    s_port_tbl[ port ].tx_tail      = 0;
+
+    // TX interrupt is enabled on demand when data is queued
+    usart_set_rx_complete_interrupt_enabled( port, true );
+
+} /* usart_buf_init() */
+
+
+bool usart_buf_rx( usart_port_t port, uint8_t* byte )
+{
+    validate_port( port );
+
+    uint8_t tail = s_port_tbl[ port ].rx_tail;
+    if( tail == s_port_tbl[ port ].rx_head )
+        return( false );
+
+    * byte = s_port_tbl[ port ].rx_buf[ tail & RX_MASK ];
+    s_port_tbl[ port ].rx_tail = tail + 1;
+
+    return( true );
+
+} /* usart_buf_rx() */
+
+
+void usart_buf_set_rx_callback( usart_port_t port, usart_buf_rx_callback_t callback )
+{
+    validate_port( port );
+
+    // Pointer is two bytes wide, so it must not be torn by the RX ISR
+    bool int_en = is_bit_set( SREG, SREG_I );
+    if( int_en ) cli();
+    s_port_tbl[ port ].rx_callback = callback;
+    if( int_en ) sei();
+
+} /* usart_buf_set_rx_callback() */
+
+
+bool usart_buf_tx( usart_port_t port, uint8_t byte )
+{
+    return( usart_buf_tx_data( port, & byte, 1 ) == 1 );
+
+} /* usart_buf_tx() */
+
+
+size_t usart_buf_tx_data( usart_port_t port, void const* data, size_t data_sz )
+{
+    validate_port( port );
+
+    uint8_t const* bytes = ( uint8_t const* )data;
+    uint8_t head = s_port_tbl[ port ].tx_head;
+    size_t count = 0;
+
+    while( count < data_sz && ( uint8_t )( head - s_port_tbl[ port ].tx_tail ) < USART_BUF_TX_SIZE )
+        s_port_tbl[ port ].tx_buf[ ( head++ ) & TX_MASK ] = bytes[ count++ ];
+
+    // Publish the new head, then make sure the ISR is running to drain it
+    if( count > 0 )
+    {
+        s_port_tbl[ port ].tx_head = head;
+        usart_set_data_empty_interrupt_enabled( port, true );
+    }
+
+    return( count );
+
+} /* usart_buf_tx_data() */
+
+
+size_t usart_buf_tx_string( usart_port_t port, char const* str )
+{
+    validate_port( port );
+
+    uint8_t head = s_port_tbl[ port ].tx_head;
+    size_t count = 0;
+
+    while( str[ count ] != '\0' && ( uint8_t )( head - s_port_tbl[ port ].tx_tail ) < USART_BUF_TX_SIZE )
+        s_port_tbl[ port ].tx_buf[ ( head++ ) & TX_MASK ] = ( uint8_t )str[ count++ ];
+
+    // Publish the new head, then make sure the ISR is running to drain it
+    if( count > 0 )
+    {
+        s_port_tbl[ port ].tx_head = head;
+        usart_set_data_empty_interrupt_enabled( port, true );
+    }
+
+    return( count );
+
+} /* usart_buf_tx_string() */
+
+
+static inline __attribute__(( always_inline )) void handle_rx( usart_port_t port, uint8_t byte )
+{
+    uint8_t head = s_port_tbl[ port ].rx_head;
+    if( ( uint8_t )( head - s_port_tbl[ port ].rx_tail ) < USART_BUF_RX_SIZE )
+    {
+        s_port_tbl[ port ].rx_buf[ head & RX_MASK ] = byte;
+        s_port_tbl[ port ].rx_head = head + 1;
+    }
+    else
+    {
+        s_port_tbl[ port ].rx_overflow = true;
+    }
+
+    usart_buf_rx_callback_t callback = s_port_tbl[ port ].rx_callback;
+    if( callback )
+        callback( port, byte );
+
+} /* handle_rx() */
+
+
+static inline __attribute__(( always_inline )) bool handle_udre( usart_port_t port, register_t udr )
+{
+    uint8_t tail = s_port_tbl[ port ].tx_tail;
+    if( tail == s_port_tbl[ port ].tx_head )
+        return( false );
+
+    * udr = s_port_tbl[ port ].tx_buf[ tail & TX_MASK ];
+    s_port_tbl[ port ].tx_tail = tail + 1;
+
+    return( true );
+
+} /* handle_udre() */
+
+
+#if( _USART_PORT_COUNT > 0 )
+    DEFINE_ISRS( 0 )
+#endif
+#if( _USART_PORT_COUNT > 1 )
+    DEFINE_ISRS( 1 )
+#endif
+#if( _USART_PORT_COUNT > 2 )
+    DEFINE_ISRS( 2 )
+#endif
+#if( _USART_PORT_COUNT > 3 )
+    DEFINE_ISRS( 3 )
+#endif
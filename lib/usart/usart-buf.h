@@ -0,0 +1,125 @@
+/**
+ * @file    usart-buf.h
+ * @brief   Header for the interrupt-driven, buffered mode of the USART driver library.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * In buffered mode, each USART port owns a pair of ring buffers. Transmitted bytes are queued and clocked out by the
+ * data register empty interrupt, and received bytes are queued by the RX complete interrupt. None of the procedures in
+ * this module ever block.
+ *
+ * The interrupt handlers for every port are defined by this module, so applications using buffered mode must not
+ * define their own `USARTn_RX` or `USARTn_UDRE` interrupt handlers.
+ */
+
+#if !defined( USART_USART_BUF_H )
+#define USART_USART_BUF_H
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "usart.h"
+
+/* -- Constants -- */
+
+/**
+ * @def     USART_BUF_RX_SIZE
+ * @brief   Size of the RX ring buffer for each port, in bytes.
+ * @note    Must be a power of two, no larger than 128.
+ */
+#if !defined( USART_BUF_RX_SIZE )
+    #define USART_BUF_RX_SIZE       32
+#endif
+
+/**
+ * @def     USART_BUF_TX_SIZE
+ * @brief   Size of the TX ring buffer for each port, in bytes.
+ * @note    Must be a power of two, no larger than 128.
+ */
+#if !defined( USART_BUF_TX_SIZE )
+    #define USART_BUF_TX_SIZE       64
+#endif
+
+/* -- Types -- */
+
+/**
+ * @typedef usart_buf_rx_callback_t
+ * @brief   Callback invoked from the RX complete interrupt after a byte has been received.
+ * @note    The callback runs in interrupt context. The byte has already been queued (unless the RX buffer was full), so
+ *          the callback should normally do nothing more than notify the main loop.
+ */
+typedef void ( * usart_buf_rx_callback_t )( usart_port_t port, uint8_t byte );
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      usart_buf_get_rx_count( usart_port_t )
+ * @brief   Returns the number of received bytes waiting in the RX buffer for the specified port.
+ */
+uint8_t usart_buf_get_rx_count( usart_port_t port );
+
+/**
+ * @fn      usart_buf_get_rx_overflow( usart_port_t )
+ * @brief   Returns `true` if any received bytes were dropped because the RX buffer was full, and clears the flag.
+ */
+bool usart_buf_get_rx_overflow( usart_port_t port );
+
+/**
+ * @fn      usart_buf_get_tx_free( usart_port_t )
+ * @brief   Returns the number of bytes which may currently be queued for transmission on the specified port.
+ */
+uint8_t usart_buf_get_tx_free( usart_port_t port );
+
+/**
+ * @fn      usart_buf_get_tx_idle( usart_port_t )
+ * @brief   Returns `true` if the TX buffer for the specified port is empty.
+ * @note    The final byte may still be in the process of being shifted out by the hardware.
+ */
+bool usart_buf_get_tx_idle( usart_port_t port );
+
+/**
+ * @fn      usart_buf_init( usart_port_t )
+ * @brief   Resets the ring buffers for the specified port and enables the RX complete interrupt.
+ * @note    The port must still be configured (baud, framing, TX/RX enablement) using the regular USART procedures.
+ */
+void usart_buf_init( usart_port_t port );
+
+/**
+ * @fn      usart_buf_rx( usart_port_t, uint8_t* )
+ * @brief   Removes the oldest received byte from the RX buffer of the specified port.
+ * @returns `true` if a byte was written to `byte`, or `false` if the RX buffer was empty.
+ */
+bool usart_buf_rx( usart_port_t port, uint8_t* byte );
+
+/**
+ * @fn      usart_buf_set_rx_callback( usart_port_t, usart_buf_rx_callback_t )
+ * @brief   Sets the callback invoked for each byte received on the specified port, or `NULL` for no callback.
+ */
+void usart_buf_set_rx_callback( usart_port_t port, usart_buf_rx_callback_t callback );
+
+/**
+ * @fn      usart_buf_tx( usart_port_t, uint8_t )
+ * @brief   Queues a single byte for transmission on the specified port.
+ * @returns `true` if the byte was queued, or `false` if the TX buffer was full.
+ */
+bool usart_buf_tx( usart_port_t port, uint8_t byte );
+
+/**
+ * @fn      usart_buf_tx_data( usart_port_t, void const*, size_t )
+ * @brief   Queues as much of the specified data as will fit into the TX buffer of the specified port.
+ * @returns The number of bytes which were queued.
+ */
+size_t usart_buf_tx_data( usart_port_t port, void const* data, size_t data_sz );
+
+/**
+ * @fn      usart_buf_tx_string( usart_port_t, char const* )
+ * @brief   Queues as much of the specified null-terminated string as will fit into the TX buffer of the specified port.
+ * @returns The number of characters which were queued.
+ */
+size_t usart_buf_tx_string( usart_port_t port, char const* str );
+
+#endif /* !defined( USART_USART_BUF_H ) */
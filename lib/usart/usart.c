@@ -12,8 +12,10 @@
 #include <stdint.h>
 
 #include <avr/io.h>
+#include <avr/pgmspace.h>
 #include <util/setbaud.h>
 
+#include "prr/prr.h"
 #include "zero/bit_ops.h"
 #include "zero/pinout.h"
 #include "zero/register.h"
@@ -24,27 +26,31 @@
 /* -- Macros -- */
 
 // Helper macro for the register table below
+// (only the UCSRnA address is stored - every port uses the same register layout relative to it)
 #define DEFINE_REGISTERS( _port )                                               \
-    { REGISTER_ADDR( UDR ## _port ),                                            \
-      REGISTER_ADDR( UCSR ## _port ## A ),                                      \
-      REGISTER_ADDR( UCSR ## _port ## B ),                                      \
-      REGISTER_ADDR( UCSR ## _port ## C ),                                      \
-      REGISTER_ADDR( UBRR ## _port ## H ),                                      \
-      REGISTER_ADDR( UBRR ## _port ## L ) }
-
-// Helper macros to get specific registers
-#define PORT_UDR( _port )                                                       \
-    ( * s_reg_tbl[ _port ].udr )
-#define PORT_UCSRA( _port )                                                     \
-    ( * s_reg_tbl[ _port ].ucsra )
-#define PORT_UCSRB( _port )                                                     \
-    ( * s_reg_tbl[ _port ].ucsrb )
-#define PORT_UCSRC( _port )                                                     \
-    ( * s_reg_tbl[ _port ].ucsrc )
-#define PORT_UBRRH( _port )                                                     \
-    ( * s_reg_tbl[ _port ].ubrrh )
-#define PORT_UBRRL( _port )                                                     \
-    ( * s_reg_tbl[ _port ].ubrrl )
+    _SFR_MEM_ADDR( UCSR ## _port ## A )
+
+// Offsets of each register from UCSRnA
+#define OFFSET_UDR                  ( _SFR_MEM_ADDR( UDR0 )   - _SFR_MEM_ADDR( UCSR0A ) )
+#define OFFSET_UCSRA                ( _SFR_MEM_ADDR( UCSR0A ) - _SFR_MEM_ADDR( UCSR0A ) )
+#define OFFSET_UCSRB                ( _SFR_MEM_ADDR( UCSR0B ) - _SFR_MEM_ADDR( UCSR0A ) )
+#define OFFSET_UCSRC                ( _SFR_MEM_ADDR( UCSR0C ) - _SFR_MEM_ADDR( UCSR0A ) )
+#define OFFSET_UBRRH                ( _SFR_MEM_ADDR( UBRR0H ) - _SFR_MEM_ADDR( UCSR0A ) )
+#define OFFSET_UBRRL                ( _SFR_MEM_ADDR( UBRR0L ) - _SFR_MEM_ADDR( UCSR0A ) )
+
+// Helper macros to get specific registers, given the base returned by lookup_base()
+#define BASE_UDR( _base )                                                       \
+    ( ( _base )[ OFFSET_UDR ] )
+#define BASE_UCSRA( _base )                                                     \
+    ( ( _base )[ OFFSET_UCSRA ] )
+#define BASE_UCSRB( _base )                                                     \
+    ( ( _base )[ OFFSET_UCSRB ] )
+#define BASE_UCSRC( _base )                                                     \
+    ( ( _base )[ OFFSET_UCSRC ] )
+#define BASE_UBRRH( _base )                                                     \
+    ( ( _base )[ OFFSET_UBRRH ] )
+#define BASE_UBRRL( _base )                                                     \
+    ( ( _base )[ OFFSET_UBRRL ] )
 
 // Helper macros to validate arguments
 #define validate_data_bits( _data_bits )    validate_enum( _data_bits,  USART_DATA_BITS_COUNT )
@@ -54,17 +60,8 @@
 
 /* -- Constants -- */
 
-// Register lookup table for each USART port
-static struct
-{
-    register_t  udr;
-    register_t  ucsra;
-    register_t  ucsrb;
-    register_t  ucsrc;
-    register_t  ubrrh;
-    register_t  ubrrl;
-}
-const s_reg_tbl[] =
+// Register lookup table for each USART port (stored in flash)
+static uint16_t const s_reg_tbl[] PROGMEM =
 {
 #if( _USART_PORT_COUNT > 0 )
     DEFINE_REGISTERS( 0 ),
@@ -83,18 +80,40 @@ const s_reg_tbl[] =
 // Ensure register table has an entry for every defined port
 _Static_assert( array_count( s_reg_tbl ) == USART_PORT_COUNT, "s_reg_tbl must have correct number of entries!" );
 
+/* -- Variables -- */
+
+// Bitmask of the ports which are acquired from the power reduction register manager
+static uint8_t s_powered = 0;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      lookup_base( usart_port_t )
+ * @brief   Returns the UCSRnA register for the specified port. All other registers are at fixed offsets from it.
+ */
+static inline register_t lookup_base( usart_port_t port );
+
+/**
+ * @fn      set_powered( usart_port_t, bool )
+ * @brief   Acquires or releases the specified port's clock, if it is not already in the requested state.
+ * @note    Each port's registers can only be written while it is powered, so every configuration function powers it.
+ */
+static void set_powered( usart_port_t port, bool powered );
+
 /* -- Procedures -- */
 
 void usart_autoconfigure_baud( usart_port_t port )
 {
     validate_port( port );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
 
-    PORT_UBRRH( port ) = UBRRH_VALUE;
-    PORT_UBRRL( port ) = UBRRL_VALUE;
+    BASE_UBRRH( base ) = UBRRH_VALUE;
+    BASE_UBRRL( base ) = UBRRL_VALUE;
     #if( USE_2X )
-        set_bit( PORT_UCSRA( port ), U2X0 );
+        set_bit( BASE_UCSRA( base ), U2X0 );
     #else
-        clear_bit( PORT_UCSRA( port ), U2X0 );
+        clear_bit( BASE_UCSRA( base ), U2X0 );
     #endif
 
 } /* usart_autoconfigure_baud() */
@@ -103,7 +122,8 @@ void usart_autoconfigure_baud( usart_port_t port )
 bool usart_get_rx_enabled( usart_port_t port )
 {
     validate_port( port );
-    return( ( bool )is_bit_set( PORT_UCSRB( port ), RXEN0 ) );
+    register_t base = lookup_base( port );
+    return( ( bool )is_bit_set( BASE_UCSRB( base ), RXEN0 ) );
 
 } /* usart_get_rx_enabled() */
 
@@ -111,7 +131,8 @@ bool usart_get_rx_enabled( usart_port_t port )
 bool usart_get_tx_enabled( usart_port_t port )
 {
     validate_port( port );
-    return( ( bool )is_bit_set( PORT_UCSRB( port ), TXEN0 ) );
+    register_t base = lookup_base( port );
+    return( ( bool )is_bit_set( BASE_UCSRB( base ), TXEN0 ) );
 
 } /* usart_get_tx_enabled() */
 
@@ -119,7 +140,8 @@ bool usart_get_tx_enabled( usart_port_t port )
 uint8_t usart_read( usart_port_t port )
 {
     validate_port( port );
-    return( ( uint8_t )PORT_UDR( port ) );
+    register_t base = lookup_base( port );
+    return( ( uint8_t )BASE_UDR( base ) );
 
 } /* usart_read() */
 
@@ -152,36 +174,38 @@ size_t usart_rx_until( usart_port_t port, char terminator, char* buf, size_t buf
 void usart_set_data_bits( usart_port_t port, usart_data_bits_t data_bits )
 {
     validate_port( port );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
     validate_data_bits( data_bits );
 
     switch( data_bits )
     {
     case USART_DATA_BITS_5:
         // UCSZ = 000
-        clear_bit( PORT_UCSRB( port ), UCSZ02 );
-        clear_bit( PORT_UCSRC( port ), UCSZ01 );
-        clear_bit( PORT_UCSRC( port ), UCSZ00 );
+        clear_bit( BASE_UCSRB( base ), UCSZ02 );
+        clear_bit( BASE_UCSRC( base ), UCSZ01 );
+        clear_bit( BASE_UCSRC( base ), UCSZ00 );
         break;
 
     case USART_DATA_BITS_6:
         // UCSZ = 001
-        clear_bit( PORT_UCSRB( port ), UCSZ02 );
-        clear_bit( PORT_UCSRC( port ), UCSZ01 );
-        set_bit(   PORT_UCSRC( port ), UCSZ00 );
+        clear_bit( BASE_UCSRB( base ), UCSZ02 );
+        clear_bit( BASE_UCSRC( base ), UCSZ01 );
+        set_bit(   BASE_UCSRC( base ), UCSZ00 );
         break;
 
     case USART_DATA_BITS_7:
         // UCSZ = 010
-        clear_bit( PORT_UCSRB( port ), UCSZ02 );
-        set_bit(   PORT_UCSRC( port ), UCSZ01 );
-        clear_bit( PORT_UCSRC( port ), UCSZ00 );
+        clear_bit( BASE_UCSRB( base ), UCSZ02 );
+        set_bit(   BASE_UCSRC( base ), UCSZ01 );
+        clear_bit( BASE_UCSRC( base ), UCSZ00 );
         break;
 
     case USART_DATA_BITS_8:
         // UCSZ = 011
-        clear_bit( PORT_UCSRB( port ), UCSZ02 );
-        set_bit(   PORT_UCSRC( port ), UCSZ01 );
-        set_bit(   PORT_UCSRC( port ), UCSZ00 );
+        clear_bit( BASE_UCSRB( base ), UCSZ02 );
+        set_bit(   BASE_UCSRC( base ), UCSZ01 );
+        set_bit(   BASE_UCSRC( base ), UCSZ00 );
         break;
 
     default:
@@ -194,7 +218,9 @@ void usart_set_data_bits( usart_port_t port, usart_data_bits_t data_bits )
 void usart_set_data_empty_interrupt_enabled( usart_port_t port, bool enabled )
 {
     validate_port( port );
-    assign_bit( PORT_UCSRB( port ), UDRIE0, enabled );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
+    assign_bit( BASE_UCSRB( base ), UDRIE0, enabled );
 
 } /* usart_set_data_empty_interrupt_enabled() */
 
@@ -202,26 +228,28 @@ void usart_set_data_empty_interrupt_enabled( usart_port_t port, bool enabled )
 void usart_set_parity( usart_port_t port, usart_parity_t parity )
 {
     validate_port( port );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
     validate_parity( parity );
 
     switch( parity )
     {
     case USART_PARITY_NONE:
         // UPM = 00
-        clear_bit( PORT_UCSRC( port ), UPM01 );
-        clear_bit( PORT_UCSRC( port ), UPM00 );
+        clear_bit( BASE_UCSRC( base ), UPM01 );
+        clear_bit( BASE_UCSRC( base ), UPM00 );
         break;
 
     case USART_PARITY_EVEN:
         // UPM = 10
-        set_bit(   PORT_UCSRC( port ), UPM01 );
-        clear_bit( PORT_UCSRC( port ), UPM00 );
+        set_bit(   BASE_UCSRC( base ), UPM01 );
+        clear_bit( BASE_UCSRC( base ), UPM00 );
         break;
 
     case USART_PARITY_ODD:
         // UPM = 11
-        set_bit(   PORT_UCSRC( port ), UPM01 );
-        set_bit(   PORT_UCSRC( port ), UPM00 );
+        set_bit(   BASE_UCSRC( base ), UPM01 );
+        set_bit(   BASE_UCSRC( base ), UPM00 );
         break;
 
     default:
@@ -234,7 +262,9 @@ void usart_set_parity( usart_port_t port, usart_parity_t parity )
 void usart_set_rx_complete_interrupt_enabled( usart_port_t port, bool enabled )
 {
     validate_port( port );
-    assign_bit( PORT_UCSRB( port ), RXCIE0, enabled );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
+    assign_bit( BASE_UCSRB( base ), RXCIE0, enabled );
 
 } /* usart_set_rx_complete_interrupt_enabled() */
 
@@ -242,7 +272,13 @@ void usart_set_rx_complete_interrupt_enabled( usart_port_t port, bool enabled )
 void usart_set_rx_enabled( usart_port_t port, bool enabled )
 {
     validate_port( port );
-    assign_bit( PORT_UCSRB( port ), RXEN0, enabled );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
+    assign_bit( BASE_UCSRB( base ), RXEN0, enabled );
+
+    // The port is powered down once neither direction is enabled
+    if( is_bitmask_clear( BASE_UCSRB( base ), bitmask2( RXEN0, TXEN0 ) ) )
+        set_powered( port, false );
 
 } /* usart_set_rx_enabled() */
 
@@ -250,16 +286,18 @@ void usart_set_rx_enabled( usart_port_t port, bool enabled )
 void usart_set_stop_bits( usart_port_t port, usart_stop_bits_t stop_bits )
 {
     validate_port( port );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
     validate_stop_bits( stop_bits );
 
     switch( stop_bits )
     {
     case USART_STOP_BITS_1:
-        clear_bit( PORT_UCSRC( port ), USBS0 );
+        clear_bit( BASE_UCSRC( base ), USBS0 );
         break;
 
     case USART_STOP_BITS_2:
-        set_bit( PORT_UCSRC( port ), USBS0 );
+        set_bit( BASE_UCSRC( base ), USBS0 );
         break;
 
     default:
@@ -272,7 +310,9 @@ void usart_set_stop_bits( usart_port_t port, usart_stop_bits_t stop_bits )
 void usart_set_tx_complete_interrupt_enabled( usart_port_t port, bool enabled )
 {
     validate_port( port );
-    assign_bit( PORT_UCSRB( port ), TXCIE0, enabled );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
+    assign_bit( BASE_UCSRB( base ), TXCIE0, enabled );
 
 } /* usart_set_tx_complete_interrupt_enabled() */
 
@@ -280,7 +320,13 @@ void usart_set_tx_complete_interrupt_enabled( usart_port_t port, bool enabled )
 void usart_set_tx_enabled( usart_port_t port, bool enabled )
 {
     validate_port( port );
-    assign_bit( PORT_UCSRB( port ), TXEN0, enabled );
+    set_powered( port, true );
+    register_t base = lookup_base( port );
+    assign_bit( BASE_UCSRB( base ), TXEN0, enabled );
+
+    // The port is powered down once neither direction is enabled
+    if( is_bitmask_clear( BASE_UCSRB( base ), bitmask2( RXEN0, TXEN0 ) ) )
+        set_powered( port, false );
 
 } /* usart_set_tx_enabled() */
 
@@ -309,7 +355,8 @@ void usart_tx_string( usart_port_t port, char const* str )
 void usart_wait_data_empty( usart_port_t port )
 {
     validate_port( port );
-    wait_bit_set( PORT_UCSRA( port ), UDRE0 );
+    register_t base = lookup_base( port );
+    wait_bit_set( BASE_UCSRA( base ), UDRE0 );
 
 } /* usart_wait_data_empty() */
 
@@ -317,7 +364,8 @@ void usart_wait_data_empty( usart_port_t port )
 void usart_wait_rx_complete( usart_port_t port )
 {
     validate_port( port );
-    wait_bit_set( PORT_UCSRA( port ), RXC0 );
+    register_t base = lookup_base( port );
+    wait_bit_set( BASE_UCSRA( base ), RXC0 );
 
 } /* usart_wait_rx_complete() */
 
@@ -325,7 +373,8 @@ void usart_wait_rx_complete( usart_port_t port )
 void usart_wait_tx_complete( usart_port_t port )
 {
     validate_port( port );
-    wait_bit_set( PORT_UCSRA( port ), TXC0 );
+    register_t base = lookup_base( port );
+    wait_bit_set( BASE_UCSRA( base ), TXC0 );
 
 } /* usart_wait_tx_complete() */
 
@@ -333,6 +382,29 @@ void usart_wait_tx_complete( usart_port_t port )
 void usart_write( usart_port_t port, uint8_t byte )
 {
     validate_port( port );
-    PORT_UDR( port ) = byte;
+    register_t base = lookup_base( port );
+    BASE_UDR( base ) = byte;
 
 } /* usart_write() */
+
+
+static inline register_t lookup_base( usart_port_t port )
+{
+    return( REGISTER_AT( pgm_read_word( & s_reg_tbl[ port ] ) ) );
+
+} /* lookup_base() */
+
+
+static void set_powered( usart_port_t port, bool powered )
+{
+    if( is_bit_set( s_powered, port ) == powered )
+        return;
+
+    // The USART modules are consecutive in prr_module_t, in port order
+    if( powered )
+        prr_acquire( PRR_MODULE_USART0 + port );
+    else
+        prr_release( PRR_MODULE_USART0 + port );
+    assign_bit( s_powered, port, powered );
+
+} /* set_powered() */
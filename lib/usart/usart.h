@@ -167,6 +167,7 @@ void usart_set_rx_complete_interrupt_enabled( usart_port_t port, bool enabled );
 /**
  * @fn      usart_set_rx_enabled( usart_port_t, bool )
  * @brief   Enables or disables RX for the specified USART port.
+ * @note    The port's clock is stopped once both RX and TX are disabled, so any transmission must be complete.
  */
 void usart_set_rx_enabled( usart_port_t port, bool enabled );
 
@@ -179,6 +180,7 @@ void usart_set_stop_bits( usart_port_t port, usart_stop_bits_t stop_bits );
 /**
  * @fn      usart_set_tx_enabled( usart_port_t, bool )
  * @brief   Enables or disables TX for the specified USART port.
+ * @note    The port's clock is stopped once both RX and TX are disabled, so any transmission must be complete.
  */
 void usart_set_tx_enabled( usart_port_t port, bool enabled );
 
@@ -23,6 +23,8 @@
 
     // Peripheral counts
     #define _GPIO_PIN_COUNT                 ( 20 )
+    #define _GPIO_EXT_INT_COUNT             ( 2 )
+    #define _GPIO_PCINT_BANK_COUNT          ( 3 )
     #define _USART_PORT_COUNT               ( 1 )
 
     // GPIO_PIN_ARDUINO_D0
@@ -113,6 +115,8 @@
 
     // Peripheral counts
     #define _GPIO_PIN_COUNT                 ( 70 )
+    #define _GPIO_EXT_INT_COUNT             ( 8 )
+    #define _GPIO_PCINT_BANK_COUNT          ( 3 )
     #define _USART_PORT_COUNT               ( 4 )
 
     // GPIO_PIN_ARDUINO_D0
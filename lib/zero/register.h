@@ -30,4 +30,11 @@ typedef volatile uint8_t* register_t;
 #define REGISTER_ADDR( _reg )                                                   \
     ( ( register_t )( & ( _reg ) ) )
 
+/**
+ * @def     REGISTER_AT
+ * @brief   Returns the register at the specified data memory address as a `register_t`.
+ */
+#define REGISTER_AT( _addr )                                                    \
+    ( ( register_t )( uintptr_t )( _addr ) )
+
 #endif /* !defined( ZERO_REGISTER_H ) */
@@ -22,6 +22,13 @@
 #define array_count( _a )                                                       \
     ( sizeof( _a ) / sizeof( _a[ 0 ] ) )
 
+/**
+ * @def     compiler_barrier
+ * @brief   Prevents the compiler from reordering memory accesses across this point.
+ */
+#define compiler_barrier()                                                      \
+    __asm__ __volatile__( "" ::: "memory" )
+
 /**
  * @def     stringize
  * @brief   Returns a string representation of the argument.
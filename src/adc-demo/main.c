@@ -14,24 +14,69 @@
 #include <string.h>
 
 #include <avr/interrupt.h>
-#include <util/delay.h>
+#include <avr/pgmspace.h>
 
 #include "adc/adc.h"
+#include "event/event.h"
 #include "lcdtext/lcdtext.h"
+#include "lcdtext/lcdtext-fb.h"
+#include "lcdtext/lcdtext-glyph.h"
 #include "zero/utility.h"
 
+/* -- Constants -- */
+
+#define UPDATE_MS       ( 50 )
+
+/* -- Types -- */
+
+/**
+ * @brief   Enumeration of the application-defined events.
+ */
+enum
+{
+    EVENT_ADC = EVENT_USER,         /**< ADC conversion complete.                       */
+};
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      handle_adc( event_t )
+ * @brief   Prints the most recent converted value.
+ */
+static void handle_adc( event_t event );
+
+/**
+ * @fn      handle_tick( event_t )
+ * @brief   Starts a conversion each time the update deadline is reached.
+ */
+static void handle_tick( event_t event );
+
+static void init_lcd( void );
+
 /* -- Variables -- */
 
 // LCD struct
 static lcdtext_t s_lcd;
 #define lcd ( ( lcdtext_t const * ) & s_lcd )
 
+// Framebuffer for the LCD
+static lcdtext_fb_t s_fb;
+
+// Custom glyphs for the LCD
+static lcdtext_glyph_cache_t s_glyphs;
+
 // Most recent converted value
-static uint16_t value = 0;
+static uint16_t volatile value = 0;
 
-/* -- Procedure Prototypes -- */
+// Tick at which the next conversion is started
+static uint32_t s_deadline;
 
-static void init_lcd( void );
+// Event handlers
+static event_handler_t const s_handlers[] PROGMEM =
+{
+    [ EVENT_TICK ]      = handle_tick,
+    [ EVENT_ADC ]       = handle_adc,
+};
 
 /* -- Procedures -- */
 
@@ -41,42 +86,59 @@ int main( void )
     init_lcd();
 
     // Print a hello message
-    lcdtext_write( lcd, "ADC Demo" );
+    lcdtext_fb_write_line( & s_fb, 0, "ADC Demo" );
+    lcdtext_fb_flush( & s_fb );
 
-    // Initialize and configure ADC
+    // Initialize and configure ADC - a single conversion is started on each update, rather than free running
     adc_init();
     adc_set_vref( ADC_VREF_AVCC );
     adc_set_channel( ADC_CHANNEL_ARDUINO_A0 );
-    adc_set_autotrigger_type( ADC_AUTOTRIGGER_FREE_RUN );
-    adc_set_autotrigger_enabled( true );
     adc_set_interrupt_enabled( true );
+    adc_set_enabled( true );
+    event_sleep_acquire( EVENT_SLEEP_ADC );
+
+    // The processor sleeps between updates
+    event_init( EVENT_MODE_TICKLESS );
+    s_deadline = event_tick();
+    event_schedule_tick( s_deadline );
+
+    event_run( s_handlers, array_count( s_handlers ) );
+
+} /* main() */
+
 
-    // Enable interrupts
+static void handle_adc( event_t event )
+{
+    // Get copy of value
+    cli();
+    uint16_t value_copy = value;
     sei();
 
-    // Trigger a conversion to start free running mode
-    adc_set_enabled( true );
-    adc_start();
+    // Print to the LCD, followed by a bar graph of the 10-bit value - only the cells which have changed are sent
+    char buf[ LCDTEXT_1602_LINE_LENGTH + 1 ];
+    sprintf( buf, "%4u ", value_copy );
+    lcdtext_glyph_bar( & s_glyphs, & buf[ 5 ], LCDTEXT_1602_LINE_LENGTH - 5, ( uint8_t )( value_copy >> 2 ) );
 
-    // Main loop
-    char buf[ LCDTEXT_2004_LINE_LENGTH + 1 ];
-    while( true )
-    {
-        // Delay some reasonable value
-        _delay_ms( 50 );
+    // Uploading a glyph for the bar moves the LCD's address counter
+    if( lcdtext_glyph_was_uploaded( & s_glyphs ) )
+        lcdtext_fb_forget_address( & s_fb );
+    lcdtext_fb_write_line( & s_fb, 1, buf );
+    lcdtext_fb_flush( & s_fb );
 
-        // Get copy of value
-        cli();
-        uint16_t value_copy = value;
-        sei();
+} /* handle_adc() */
 
-        // Print to the LCD
-        sprintf( buf, "%-" stringize_value( LCDTEXT_2004_LINE_LENGTH ) "d", value );
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_2 );
-        lcdtext_write( lcd, buf );
-    }
 
-} /* main() */
+static void handle_tick( event_t event )
+{
+    if( ( int32_t )( event_tick() - s_deadline ) < 0 )
+        return;
+
+    adc_start();
+
+    s_deadline += UPDATE_MS;
+    event_schedule_tick( s_deadline );
+
+} /* handle_tick() */
 
 
 static void init_lcd( void )
@@ -101,6 +163,8 @@ static void init_lcd( void )
 
     // Initialize LCD
     lcdtext_init( & s_lcd );
+    lcdtext_fb_init( & s_fb, lcd, LCDTEXT_1602_LINE_LENGTH, 2 );
+    lcdtext_glyph_init( & s_glyphs, lcd );
 
 } /* init_lcd() */
 
@@ -108,5 +172,6 @@ static void init_lcd( void )
 ISR( ADC_vect )
 {
     value = adc_get();
+    event_set_pending( EVENT_ADC );
 
 } /* ISR( ADC_vect ) */
@@ -9,27 +9,61 @@
 /* -- Includes -- */
 
 #include <stdbool.h>
+#include <stdint.h>
 
-#include <util/delay.h>
+#include <avr/pgmspace.h>
 
+#include "event/event.h"
 #include "gpio/gpio.h"
+#include "zero/utility.h"
 
 /* -- Constants -- */
 
 #define DELAY   ( 25 )
 
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      handle_tick( event_t )
+ * @brief   Toggles the LED each time the blink deadline is reached.
+ */
+static void handle_tick( event_t event );
+
+/* -- Variables -- */
+
+// Tick at which the LED is next toggled
+static uint32_t s_deadline;
+
+// Event handlers
+static event_handler_t const s_handlers[] PROGMEM =
+{
+    [ EVENT_TICK ]      = handle_tick,
+};
+
 /* -- Procedures -- */
 
 int main( void )
 {
-    gpio_set_dir( GPIO_PIN_ARDUINO_BUILT_IN_LED, GPIO_DIR_OUT );
+    gpio_fast_set_dir( GPIO_PIN_ARDUINO_BUILT_IN_LED, GPIO_DIR_OUT );
 
-    while( true )
-    {
-        gpio_set_state( GPIO_PIN_ARDUINO_BUILT_IN_LED, GPIO_STATE_HIGH );
-        _delay_ms( DELAY );
-        gpio_set_state( GPIO_PIN_ARDUINO_BUILT_IN_LED, GPIO_STATE_LOW );
-        _delay_ms( DELAY );
-    }
+    // The processor sleeps between toggles
+    event_init( EVENT_MODE_TICKLESS );
+    s_deadline = event_tick() + DELAY;
+    event_schedule_tick( s_deadline );
+
+    event_run( s_handlers, array_count( s_handlers ) );
 
 } /* main() */
+
+
+static void handle_tick( event_t event )
+{
+    if( ( int32_t )( event_tick() - s_deadline ) < 0 )
+        return;
+
+    gpio_fast_toggle_state( GPIO_PIN_ARDUINO_BUILT_IN_LED );
+
+    s_deadline += DELAY;
+    event_schedule_tick( s_deadline );
+
+} /* handle_tick() */
@@ -0,0 +1,181 @@
+/**
+ * @file    main.c
+ * @brief   Main module for the kernel-demo executable.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ *
+ * Three tasks share the USART: a producer sends a counter to a consumer through a queue, the consumer prints each
+ * value, and a monitor periodically prints the longest context switch and the unused stack of each task. The USART is
+ * protected by a mutex, and the idle task blinks the LED.
+ */
+
+/* -- Includes -- */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <avr/sleep.h>
+
+#include "gpio/gpio.h"
+#include "kernel/kernel.h"
+#include "usart/usart.h"
+#include "zero/utility.h"
+
+/* -- Constants -- */
+
+#define PORT            ( USART_PORT_0 )
+#define STACK_SIZE      ( 192 )
+#define QUEUE_CAPACITY  ( 4 )
+
+/* -- Types -- */
+
+/**
+ * @brief   Enumeration of the task priorities.
+ */
+enum
+{
+    PRIORITY_CONSUMER,              /**< Consumer task (highest priority).              */
+    PRIORITY_PRODUCER,              /**< Producer task.                                 */
+    PRIORITY_MONITOR,               /**< Monitor task.                                  */
+};
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      consumer( void* )
+ * @brief   Prints each value received from the queue.
+ */
+static void consumer( void* arg );
+
+/**
+ * @fn      monitor( void* )
+ * @brief   Periodically prints the kernel's measurements.
+ */
+static void monitor( void* arg );
+
+/**
+ * @fn      print( char const* )
+ * @brief   Prints the specified string while holding the USART mutex.
+ */
+static void print( char const* str );
+
+/**
+ * @fn      producer( void* )
+ * @brief   Sends an incrementing counter to the queue.
+ */
+static void producer( void* arg );
+
+/* -- Variables -- */
+
+// Tasks and their stacks
+static kernel_task_t    s_consumer;
+static kernel_task_t    s_monitor;
+static kernel_task_t    s_producer;
+static uint8_t          s_consumer_stack[ STACK_SIZE ];
+static uint8_t          s_monitor_stack[ STACK_SIZE ];
+static uint8_t          s_producer_stack[ STACK_SIZE ];
+
+// Queue from the producer to the consumer
+static kernel_queue_t   s_queue;
+static uint16_t         s_queue_buf[ QUEUE_CAPACITY ];
+
+// Mutex protecting the USART
+static kernel_mutex_t   s_usart_mutex;
+
+/* -- Procedures -- */
+
+int main( void )
+{
+    // Initialize the USART
+    usart_autoconfigure_baud( PORT );
+    usart_set_data_bits( PORT, USART_DATA_BITS_8 );
+    usart_set_stop_bits( PORT, USART_STOP_BITS_1 );
+    usart_set_parity( PORT, USART_PARITY_NONE );
+    usart_set_tx_enabled( PORT, true );
+
+    // Initialize the LED
+    gpio_set_dir( GPIO_PIN_ARDUINO_BUILT_IN_LED, GPIO_DIR_OUT );
+
+    // Create the kernel objects and tasks
+    kernel_mutex_init( & s_usart_mutex );
+    kernel_queue_init( & s_queue, s_queue_buf, sizeof( s_queue_buf[ 0 ] ), array_count( s_queue_buf ) );
+    kernel_task_create( & s_consumer, PRIORITY_CONSUMER, s_consumer_stack, STACK_SIZE, consumer, NULL );
+    kernel_task_create( & s_producer, PRIORITY_PRODUCER, s_producer_stack, STACK_SIZE, producer, NULL );
+    kernel_task_create( & s_monitor, PRIORITY_MONITOR, s_monitor_stack, STACK_SIZE, monitor, NULL );
+
+    // Continue as the idle task - the kernel tick runs from timer 0, so only idle sleep is allowed
+    kernel_start();
+    set_sleep_mode( SLEEP_MODE_IDLE );
+
+    uint16_t last_toggle = kernel_get_ticks();
+    while( true )
+    {
+        if( ( uint16_t )( kernel_get_ticks() - last_toggle ) >= 500 )
+        {
+            gpio_toggle_state( GPIO_PIN_ARDUINO_BUILT_IN_LED );
+            last_toggle += 500;
+        }
+        sleep_mode();
+    }
+
+} /* main() */
+
+
+static void consumer( void* arg )
+{
+    char buf[ 16 ];
+    uint16_t value;
+
+    while( true )
+    {
+        kernel_queue_receive( & s_queue, & value );
+        snprintf( buf, sizeof( buf ), "value %u\r\n", value );
+        print( buf );
+    }
+
+} /* consumer() */
+
+
+static void monitor( void* arg )
+{
+    char buf[ 48 ];
+
+    while( true )
+    {
+        kernel_delay( 5000 );
+        snprintf( buf,
+                  sizeof( buf ),
+                  "switch %u cyc, free %u/%u/%u\r\n",
+                  kernel_get_switch_cycles(),
+                  kernel_task_get_stack_unused( & s_consumer ),
+                  kernel_task_get_stack_unused( & s_producer ),
+                  kernel_task_get_stack_unused( & s_monitor ) );
+        print( buf );
+    }
+
+} /* monitor() */
+
+
+static void print( char const* str )
+{
+    kernel_mutex_lock( & s_usart_mutex );
+    usart_tx_string( PORT, str );
+    kernel_mutex_unlock( & s_usart_mutex );
+
+} /* print() */
+
+
+static void producer( void* arg )
+{
+    uint16_t value = 0;
+
+    while( true )
+    {
+        kernel_queue_send( & s_queue, & value );
+        value++;
+        kernel_delay( 250 );
+    }
+
+} /* producer() */
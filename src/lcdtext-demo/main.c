@@ -8,54 +8,95 @@
 
 /* -- Includes -- */
 
+#include <stdbool.h>
 #include <stdlib.h>
 
+#include <avr/pgmspace.h>
 #include <util/delay.h>
 
+#include "event/event.h"
 #include "gpio/gpio.h"
 #include "lcdtext/lcdtext.h"
+#include "lcdtext/lcdtext-term.h"
+#include "task/task.h"
+#include "zero/utility.h"
 
 /* -- Constants -- */
 
 #define DELAY_MS        ( 2000 )
 
+/* -- Macros -- */
+
+// Writes the specified string one character at a time, blocking the task between each character
+#define write_delay( _task, _str, _ms )                                         \
+    for( s_chr = ( _str ); * s_chr != '\0'; s_chr++ )                           \
+    {                                                                           \
+        char const buf[ 2 ] = { * s_chr, '\0' };                                \
+        lcdtext_write( lcd, buf );                                              \
+        TASK_DELAY( ( _task ), ( _ms ) );                                       \
+    }
+
 /* -- Procedure Prototypes -- */
 
 /**
- * @fn      demo_autoshift( lcdtext_t const * )
+ * @fn      demo_autoshift( task_t* )
  * @brief   Displays an infinitely repeating demo of the autoshift options.
  */
-static void demo_autoshift( lcdtext_t const * lcd );
+static task_state_t demo_autoshift( task_t* task );
 
 /**
- * @fn      demo_clear_home( lcdtext_t const * )
+ * @fn      demo_clear_home( task_t* )
  * @brief   Displays an infinitely repeating demo of the home and clear functions.
  */
-static void demo_clear_home( lcdtext_t const * lcd );
+static task_state_t demo_clear_home( task_t* task );
 
 /**
- * @fn      demo_cursors( lcdtext_t const * )
+ * @fn      demo_cursors( task_t* )
  * @brief   Displays an infinitely repeating demo of the available cursor options.
  */
-static void demo_cursors( lcdtext_t const * lcd );
+static task_state_t demo_cursors( task_t* task );
 
 /**
- * @fn      demo_display_on_off( lcdtext_t const * )
+ * @fn      demo_display_on_off( task_t* )
  * @brief   Displays an infinitely repeating demo of turning the display on and off.
  */
-static void demo_display_on_off( lcdtext_t const * lcd );
+static task_state_t demo_display_on_off( task_t* task );
 
 /**
- * @fn      demo_set_address( lcdtext_t const * )
+ * @fn      demo_set_address( task_t* )
  * @brief   Displays an infinitely repeating demo of setting the LCD's data address.
  */
-static void demo_set_address( lcdtext_t const * lcd );
+static task_state_t demo_set_address( task_t* task );
 
 /**
- * @fn      demo_shift( lcdtext_t const * )
+ * @fn      demo_shift( task_t* )
  * @brief   Displays an infinitely repeating demo of the LCD's display shift functions.
  */
-static void demo_shift( lcdtext_t const * lcd );
+static task_state_t demo_shift( task_t* task );
+
+/**
+ * @fn      demo_terminal( task_t* )
+ * @brief   Displays an infinitely repeating demo of the terminal's wrapping, newlines, and scrolling.
+ */
+static task_state_t demo_terminal( task_t* task );
+
+/* -- Variables -- */
+
+// LCD struct
+static lcdtext_t s_lcd;
+#define lcd ( ( lcdtext_t const * ) & s_lcd )
+
+// Terminal for the terminal demo
+static lcdtext_term_t s_term;
+
+// Demo task
+static task_t s_demo;
+
+// Event handlers
+static event_handler_t const s_handlers[] PROGMEM =
+{
+    [ EVENT_TICK ]      = task_handle_event,
+};
 
 /* -- Procedures -- */
 
@@ -63,210 +104,226 @@ int main( void )
 {
     _delay_ms( 500 );
 
-    lcdtext_t lcd = { 0 };
-
 #if( 1 )
     // 8 line interface
-    lcd.pins.rs             = GPIO_PIN_ARDUINO_D12;
-    lcd.pins.rw             = GPIO_PIN_ARDUINO_D11;
-    lcd.pins.e              = GPIO_PIN_ARDUINO_D10;
-    lcd.pins.d0             = GPIO_PIN_ARDUINO_D02;
-    lcd.pins.d1             = GPIO_PIN_ARDUINO_D03;
-    lcd.pins.d2             = GPIO_PIN_ARDUINO_D04;
-    lcd.pins.d3             = GPIO_PIN_ARDUINO_D05;
-    lcd.pins.d4             = GPIO_PIN_ARDUINO_D06;
-    lcd.pins.d5             = GPIO_PIN_ARDUINO_D07;
-    lcd.pins.d6             = GPIO_PIN_ARDUINO_D08;
-    lcd.pins.d7             = GPIO_PIN_ARDUINO_D09;
-    lcd.config.data_8       = true;
-    lcd.config.lines_2      = true;
-    lcd.config.font_large   = false;
+    s_lcd.pins.rs           = GPIO_PIN_ARDUINO_D12;
+    s_lcd.pins.rw           = GPIO_PIN_ARDUINO_D11;
+    s_lcd.pins.e            = GPIO_PIN_ARDUINO_D10;
+    s_lcd.pins.d0           = GPIO_PIN_ARDUINO_D02;
+    s_lcd.pins.d1           = GPIO_PIN_ARDUINO_D03;
+    s_lcd.pins.d2           = GPIO_PIN_ARDUINO_D04;
+    s_lcd.pins.d3           = GPIO_PIN_ARDUINO_D05;
+    s_lcd.pins.d4           = GPIO_PIN_ARDUINO_D06;
+    s_lcd.pins.d5           = GPIO_PIN_ARDUINO_D07;
+    s_lcd.pins.d6           = GPIO_PIN_ARDUINO_D08;
+    s_lcd.pins.d7           = GPIO_PIN_ARDUINO_D09;
+    s_lcd.config.data_8     = true;
+    s_lcd.config.lines_2    = true;
+    s_lcd.config.font_large = false;
 #else
     // 4 line interface
-    lcd.pins.rs             = GPIO_PIN_ARDUINO_D12;
-    lcd.pins.rw             = GPIO_PIN_ARDUINO_D11;
-    lcd.pins.e              = GPIO_PIN_ARDUINO_D10;
-    lcd.pins.d0             = GPIO_PIN_INVALID;
-    lcd.pins.d1             = GPIO_PIN_INVALID;
-    lcd.pins.d2             = GPIO_PIN_INVALID;
-    lcd.pins.d3             = GPIO_PIN_INVALID;
-    lcd.pins.d4             = GPIO_PIN_ARDUINO_D06;
-    lcd.pins.d5             = GPIO_PIN_ARDUINO_D07;
-    lcd.pins.d6             = GPIO_PIN_ARDUINO_D08;
-    lcd.pins.d7             = GPIO_PIN_ARDUINO_D09;
-    lcd.config.data_8       = false;
-    lcd.config.lines_2      = true;
-    lcd.config.font_large   = false;
+    s_lcd.pins.rs           = GPIO_PIN_ARDUINO_D12;
+    s_lcd.pins.rw           = GPIO_PIN_ARDUINO_D11;
+    s_lcd.pins.e            = GPIO_PIN_ARDUINO_D10;
+    s_lcd.pins.d0           = GPIO_PIN_INVALID;
+    s_lcd.pins.d1           = GPIO_PIN_INVALID;
+    s_lcd.pins.d2           = GPIO_PIN_INVALID;
+    s_lcd.pins.d3           = GPIO_PIN_INVALID;
+    s_lcd.pins.d4           = GPIO_PIN_ARDUINO_D06;
+    s_lcd.pins.d5           = GPIO_PIN_ARDUINO_D07;
+    s_lcd.pins.d6           = GPIO_PIN_ARDUINO_D08;
+    s_lcd.pins.d7           = GPIO_PIN_ARDUINO_D09;
+    s_lcd.config.data_8     = false;
+    s_lcd.config.lines_2    = true;
+    s_lcd.config.font_large = false;
 #endif
 
-    lcdtext_init( & lcd );
+    lcdtext_init( & s_lcd );
+
+    // The processor sleeps whenever the demo is waiting
+    event_init( EVENT_MODE_TICKLESS );
 
-    // demo_autoshift( & lcd );
-    // demo_clear_home( & lcd );
-    demo_cursors( & lcd );
-    // demo_display_on_off( & lcd );
-    // demo_set_address( & lcd );
-    // demo_shift( & lcd );
+    // task_start( & s_demo, demo_autoshift );
+    // task_start( & s_demo, demo_clear_home );
+    task_start( & s_demo, demo_cursors );
+    // task_start( & s_demo, demo_display_on_off );
+    // task_start( & s_demo, demo_set_address );
+    // task_start( & s_demo, demo_shift );
+    // task_start( & s_demo, demo_terminal );
+
+    event_run( s_handlers, array_count( s_handlers ) );
 
 } /* main() */
 
 
-static void demo_autoshift( lcdtext_t const * lcd )
+static task_state_t demo_autoshift( task_t* task )
 {
+    static uint16_t const DELAY = 150;
+    static char const* s_chr;
+
+    TASK_BEGIN( task );
     while( true )
     {
-        static uint16_t const DELAY = 150;
-
         lcdtext_clear( lcd );
         lcdtext_set_autoshift( lcd, LCDTEXT_AUTOSHIFT_CURSOR_RIGHT );
-        lcdtext_write_delay( lcd, "Cursor Right", DELAY );
+        write_delay( task, "Cursor Right", DELAY );
 
         lcdtext_clear( lcd );
         lcdtext_set_address( lcd, 16 );
         lcdtext_set_autoshift( lcd, LCDTEXT_AUTOSHIFT_DISPLAY_LEFT );
-        lcdtext_write_delay( lcd, "Display Left", DELAY );
+        write_delay( task, "Display Left", DELAY );
 
         lcdtext_clear( lcd );
         lcdtext_set_address( lcd, 15 );
         lcdtext_set_autoshift( lcd, LCDTEXT_AUTOSHIFT_CURSOR_LEFT );
-        lcdtext_write_delay( lcd, "Cursor Left", DELAY );
+        write_delay( task, "Cursor Left", DELAY );
 
         lcdtext_clear( lcd );
         lcdtext_set_autoshift( lcd, LCDTEXT_AUTOSHIFT_DISPLAY_RIGHT );
-        lcdtext_write_delay( lcd, "isplay Right", DELAY );
+        write_delay( task, "isplay Right", DELAY );
     }
+    TASK_END( task );
 
 } /* demo_autoshift() */
 
 
-static void demo_clear_home( lcdtext_t const * lcd )
+static task_state_t demo_clear_home( task_t* task )
 {
+    TASK_BEGIN( task );
     while( true )
     {
         lcdtext_1602_write_lines( lcd, "XXXXXXXXXXXXXXXX", "XXXXXXXXXXXXXXXX" );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
 
         lcdtext_home( lcd );
         lcdtext_write( lcd, "Called Home()" );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
 
         lcdtext_clear( lcd );
         lcdtext_write( lcd, "Called Clear()" );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
     }
+    TASK_END( task );
 
 } /* demo_clear_home() */
 
 
-static void demo_cursors( lcdtext_t const * lcd )
+static task_state_t demo_cursors( task_t* task )
 {
+    TASK_BEGIN( task );
     while( true )
     {
         lcdtext_clear( lcd );
         lcdtext_set_display( lcd, true, LCDTEXT_CURSOR_NONE );
         lcdtext_1602_write_lines( lcd, "Cursor Demo", "No Cursor" );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
 
         lcdtext_clear( lcd );
         lcdtext_set_display( lcd, true, LCDTEXT_CURSOR_UNDERSCORE );
         lcdtext_1602_write_lines( lcd, "Cursor Demo", "Underscore" );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
 
         lcdtext_clear( lcd );
         lcdtext_set_display( lcd, true, LCDTEXT_CURSOR_BOX );
         lcdtext_1602_write_lines( lcd, "Cursor Demo", "Box" );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
 
         lcdtext_clear( lcd );
         lcdtext_set_display( lcd, true, LCDTEXT_CURSOR_BOTH );
         lcdtext_1602_write_lines( lcd, "Cursor Demo", "Both" );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
     }
+    TASK_END( task );
 
 } /* demo_cursors() */
 
 
-static void demo_display_on_off( lcdtext_t const * lcd )
+static task_state_t demo_display_on_off( task_t* task )
 {
+    TASK_BEGIN( task );
     lcdtext_1602_write_lines( lcd, "Display Demo", "Toggle On/Off" );
     while( true )
     {
         lcdtext_set_display( lcd, true, LCDTEXT_CURSOR_NONE );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
 
         lcdtext_set_display( lcd, false, LCDTEXT_CURSOR_NONE );
-        _delay_ms( DELAY_MS );
+        TASK_DELAY( task, DELAY_MS );
     }
+    TASK_END( task );
 
 } /* demo_display_on_off() */
 
 
-static void demo_set_address( lcdtext_t const * lcd )
+static task_state_t demo_set_address( task_t* task )
 {
+    static uint8_t s_idx;
+
+    TASK_BEGIN( task );
     lcdtext_set_display( lcd, true, LCDTEXT_CURSOR_NONE );
     while( true )
     {
         lcdtext_clear( lcd );
 
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_1 + 0 );
-        lcdtext_write( lcd, "0" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_2 + 0 );
-        lcdtext_write( lcd, "1" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_1 + 1 );
-        lcdtext_write( lcd, "2" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_2 + 1 );
-        lcdtext_write( lcd, "3" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_1 + 2 );
-        lcdtext_write( lcd, "4" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_2 + 2 );
-        lcdtext_write( lcd, "5" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_1 + 3 );
-        lcdtext_write( lcd, "6" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_2 + 3 );
-        lcdtext_write( lcd, "7" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_1 + 4 );
-        lcdtext_write( lcd, "8" ),
-        _delay_ms( DELAY_MS );
-
-        lcdtext_set_address( lcd, LCDTEXT_ADDRESS_LINE_2 + 4 );
-        lcdtext_write( lcd, "9" ),
-        _delay_ms( DELAY_MS );
+        // Alternate between the two lines, moving one column right every two digits
+        for( s_idx = 0; s_idx < 10; s_idx++ )
+        {
+            char const buf[ 2 ] = { ( char )( '0' + s_idx ), '\0' };
+            lcdtext_set_address( lcd, ( s_idx % 2 ? LCDTEXT_ADDRESS_LINE_2 : LCDTEXT_ADDRESS_LINE_1 ) + s_idx / 2 );
+            lcdtext_write( lcd, buf );
+            TASK_DELAY( task, DELAY_MS );
+        }
     }
+    TASK_END( task );
 
 } /* demo_set_address() */
 
 
-static void demo_shift( lcdtext_t const * lcd )
+static task_state_t demo_shift( task_t* task )
 {
+    static uint8_t s_idx;
+
+    TASK_BEGIN( task );
     lcdtext_set_display( lcd, true, LCDTEXT_CURSOR_NONE );
     lcdtext_1602_write_lines( lcd, "Shift Demo", "Shift Demo" );
     while( true )
     {
-        for( uint8_t idx = 0; idx < 6; idx++ )
+        for( s_idx = 0; s_idx < 6; s_idx++ )
         {
             lcdtext_shift_right( lcd );
-            _delay_ms( 500 );
+            TASK_DELAY( task, 500 );
         }
-        for( uint8_t idx = 0; idx < 6; idx++ )
+        for( s_idx = 0; s_idx < 6; s_idx++ )
         {
             lcdtext_shift_left( lcd );
-            _delay_ms( 500 );
+            TASK_DELAY( task, 500 );
         }
     }
+    TASK_END( task );
+
 } /* demo_shift() */
+
+
+static task_state_t demo_terminal( task_t* task )
+{
+    static char const* s_chr;
+
+    TASK_BEGIN( task );
+    lcdtext_term_init( & s_term, lcd, LCDTEXT_1602_LINE_LENGTH, 2 );
+    lcdtext_set_display( lcd, true, LCDTEXT_CURSOR_UNDERSCORE );
+    while( true )
+    {
+        // Each character is flushed on its own - typing only sends the new character, and scrolling only the cells
+        // which change
+        for( s_chr = "Terminal Demo\nLong lines wrap onto the next line.\nOverwrite\rOVER\n"; * s_chr != '\0'; s_chr++ )
+        {
+            lcdtext_term_put( & s_term, * s_chr );
+            lcdtext_term_flush( & s_term );
+            TASK_DELAY( task, 150 );
+        }
+        TASK_DELAY( task, DELAY_MS );
+        lcdtext_term_clear( & s_term );
+    }
+    TASK_END( task );
+
+} /* demo_terminal() */
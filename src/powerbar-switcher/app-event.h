@@ -0,0 +1,26 @@
+/**
+ * @file    app-event.h
+ * @brief   Header defining the application events for the powerbar switcher app.
+ *
+ * @author  Chris Vig (chris@invictus.so)
+ * @date    2026-10-17
+ */
+
+#if !defined( POWERBAR_SWITCHER_APP_EVENT_H )
+#define POWERBAR_SWITCHER_APP_EVENT_H
+
+/* -- Includes -- */
+
+#include "event/event.h"
+
+/* -- Types -- */
+
+/**
+ * @brief   Enumeration of the application-defined events, in priority order.
+ */
+enum
+{
+    EVENT_COM_RX = EVENT_USER,      /**< Received serial data.                          */
+};
+
+#endif /* !defined( POWERBAR_SWITCHER_APP_EVENT_H ) */
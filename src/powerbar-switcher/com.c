@@ -13,12 +13,12 @@
 #include <stdio.h>
 #include <string.h>
 
-#include <avr/interrupt.h>
-
+#include "event/event.h"
 #include "usart/usart.h"
+#include "usart/usart-buf.h"
 
+#include "app-event.h"
 #include "com.h"
-#include "event.h"
 
 /* -- Constants -- */
 
@@ -28,13 +28,20 @@
 
 /* -- Variables -- */
 
-// Receive buffer
+// Line assembly buffer
 char        s_rx_buf[ BUF_SIZE ];
 uint8_t     s_rx_cnt = 0;
 
-// Transmit buffer
+// Formatting buffer
 char        s_tx_buf[ BUF_SIZE ];
-uint8_t     s_tx_idx = 0;
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      handle_rx_byte( usart_port_t, uint8_t )
+ * @brief   Called by the USART driver (in interrupt context) for each received byte.
+ */
+static void handle_rx_byte( usart_port_t port, uint8_t byte );
 
 /* -- Procedures -- */
 
@@ -50,14 +57,27 @@ void com_init( void )
     usart_set_tx_enabled( PORT, true );
     usart_set_rx_enabled( PORT, true );
 
-    // Enable interrupt for RX complete
-    usart_set_rx_complete_interrupt_enabled( PORT, true );
+    // Enable interrupt-driven buffered mode, with an event for each received byte
+    usart_buf_set_rx_callback( PORT, handle_rx_byte );
+    usart_buf_init( PORT );
+
+    // Commands may arrive at any time, so the receiver (which needs the I/O clock) must keep running while asleep
+    event_sleep_acquire( EVENT_SLEEP_USART_RX );
 
 } /* com_init() */
 
 
 com_rx_status_t com_rx( char* buf, size_t buf_sz )
 {
+    // Move received bytes into the line buffer, stopping at the end of a line
+    uint8_t byte;
+    while( s_rx_cnt < BUF_SIZE &&
+           ( s_rx_cnt == 0 || s_rx_buf[ s_rx_cnt - 1 ] != TERMINATOR ) &&
+           usart_buf_rx( PORT, & byte ) )
+    {
+        s_rx_buf[ s_rx_cnt++ ] = ( char )byte;
+    }
+
     if( // We have received at least one character
         s_rx_cnt > 0 &&
         // The received characters fit into the buffer provided by the caller
@@ -72,9 +92,9 @@ com_rx_status_t com_rx( char* buf, size_t buf_sz )
         s_rx_cnt = 0;
         return( COM_RX_STATUS_OK );
     }
-    else if( s_rx_cnt == BUF_SIZE )
+    else if( s_rx_cnt == BUF_SIZE || ( s_rx_cnt > 0 && s_rx_buf[ s_rx_cnt - 1 ] == TERMINATOR ) )
     {
-        // Buffer overflowed before receiving terminating char
+        // Buffer overflowed before receiving terminating char, or the line is too long for the caller's buffer
         // Reset the buffer and return an error code
         s_rx_cnt = 0;
         return( COM_RX_STATUS_OVERFLOW );
@@ -90,51 +110,29 @@ com_rx_status_t com_rx( char* buf, size_t buf_sz )
 
 void com_tx( char const* buf )
 {
-    // Copy string into the transmit buffer
-    strncpy( s_tx_buf, buf, BUF_SIZE );
-    s_tx_idx = 0;
-
-    // Enable the data register empty interrupt, which will fire immediately
-    usart_set_data_empty_interrupt_enabled( PORT, true );
+    // Queue string in the driver's transmit buffer
+    ( void )usart_buf_tx_string( PORT, buf );
 
 } /* com_tx() */
 
 
 void com_tx_fmt( char const* fmt, ... )
 {
-    // Copy string into the transmit buffer
+    // Format string into the local buffer
     va_list args;
     va_start( args, fmt );
     vsnprintf( s_tx_buf, BUF_SIZE, fmt, args );
-    s_tx_idx = 0;
     va_end( args );
 
-    // Enable the data register empty interrupt, which will fire immediately
-    usart_set_data_empty_interrupt_enabled( PORT, true );
+    // Queue string in the driver's transmit buffer
+    ( void )usart_buf_tx_string( PORT, s_tx_buf );
 
 } /* com_tx_fmt() */
 
 
-ISR( USART_RX_vect )
+static void handle_rx_byte( usart_port_t port, uint8_t byte )
 {
-    // Write to RX buffer if there's space remaining
-    if( s_rx_cnt < BUF_SIZE )
-        s_rx_buf[ s_rx_cnt++ ] = usart_read( PORT );
-    else
-        ( void )usart_read( PORT );
-
     // Trigger the COM_RX event
     event_set_pending( EVENT_COM_RX );
 
-} /* ISR( USART_RX_vect ) */
-
-
-ISR( USART_UDRE_vect )
-{
-    // Write to the data register if we still have data left
-    if( s_tx_idx < BUF_SIZE && s_tx_buf[ s_tx_idx ] != '\0' )
-        usart_write( PORT, ( uint8_t )s_tx_buf[ s_tx_idx++ ] );
-    else
-        usart_set_data_empty_interrupt_enabled( PORT, false );
-
-} /* ISR( USART_UDRE_vect ) */
+} /* handle_rx_byte() */
@@ -39,14 +39,16 @@ void com_init( void );
  *          - `COM_RX_STATUS_WAIT` indicates that input is still being received. Nothing is written to `buf`.
  *          - `COM_RX_STATUS_OVERFLOW` indicates that the RX buffer overflowed without receiving the terminator. Nothing
  *            is written to `buf`.
- * @note    This procedure is expected to be called immediately in response to an EVENT_COM_RX event. The RX buffer is
- *          flushed / reset if the return status is anything other than `COM_RX_STATUS_WAIT`.
+ * @note    This procedure is expected to be called in response to an EVENT_COM_RX event, repeatedly until it returns
+ *          `COM_RX_STATUS_WAIT`, since more than one line may have been received. The line buffer is flushed / reset if
+ *          the return status is anything other than `COM_RX_STATUS_WAIT`.
  */
 com_rx_status_t com_rx( char* buf, size_t buf_sz );
 
 /**
  * @fn      com_tx( char const* )
  * @brief   Asynchronously transmits the specified null-terminated string.
+ * @note    Never blocks. Characters which do not fit into the USART driver's TX buffer are dropped.
  */
 void com_tx( char const* buf );
 
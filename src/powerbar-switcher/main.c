@@ -10,15 +10,17 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 
-#include <avr/interrupt.h>
-#include <util/delay.h>
+#include <avr/pgmspace.h>
 
-#include "usart/usart.h"
+#include "event/event.h"
+#include "swtimer/swtimer.h"
+#include "zero/utility.h"
 
+#include "app-event.h"
 #include "com.h"
-#include "event.h"
 #include "powerbar.h"
 
 /* -- Constants -- */
@@ -30,16 +32,28 @@ static const uint32_t       TIMEOUT_MS = 10800000; // 3 hours in milliseconds
 /* -- Procedure Prototypes -- */
 
 /**
- * @fn      handle_com_rx( void )
+ * @fn      handle_com_rx( event_t )
  * @brief   Handles serial communication RX events.
  */
-static void handle_com_rx( void );
+static void handle_com_rx( event_t event );
 
 /**
- * @fn      handle_tick( void )
- * @brief   Handles the 1 millisecond tick count timer.
+ * @fn      handle_idle( event_t )
+ * @brief   Prepares for sleep once every pending event has been handled.
  */
-static void handle_tick( void );
+static void handle_idle( event_t event );
+
+/**
+ * @fn      handle_tick( event_t )
+ * @brief   Handles tick events by servicing any expired software timers.
+ */
+static void handle_tick( event_t event );
+
+/**
+ * @fn      handle_timeout( swtimer_t*, void* )
+ * @brief   Handles expiry of the powerbar timeout.
+ */
+static void handle_timeout( swtimer_t* timer, void* arg );
 
 /**
  * @fn      process_command( char const* )
@@ -47,9 +61,24 @@ static void handle_tick( void );
  */
 static void process_command( char const* cmd );
 
+/**
+ * @fn      update_timeout( void )
+ * @brief   Restarts or stops the powerbar timeout timer to match the current powerbar and timeout state.
+ */
+static void update_timeout( void );
+
 /* -- Variables -- */
 
 static bool s_timeout = true;
+static swtimer_t s_timeout_timer;
+
+// Event handlers
+static event_handler_t const s_handlers[] PROGMEM =
+{
+    [ EVENT_NONE ]      = handle_idle,
+    [ EVENT_TICK ]      = handle_tick,
+    [ EVENT_COM_RX ]    = handle_com_rx,
+};
 
 /* -- Procedures -- */
 
@@ -59,68 +88,74 @@ int main( void )
     com_init();
     powerbar_init();
 
-    // Initialize event manager
-    event_init();
+    // Initialize event manager and software timers, only waking the processor for serial traffic and the timeout
+    event_init( EVENT_MODE_TICKLESS );
+    swtimer_init( event_tick() );
+    swtimer_setup( & s_timeout_timer );
+    update_timeout();
+
+    event_run( s_handlers, array_count( s_handlers ) );
+
+} /* main() */
+
 
-    while( true )
+static void handle_com_rx( event_t event )
+{
+    // Read status from com module until all received input has been consumed
+    static char input[ INPUT_BUF_SIZE ];
+    com_rx_status_t status;
+    do
     {
-        event_t event = event_wait();
-        switch( event )
+        status = com_rx( input, INPUT_BUF_SIZE );
+        switch( status )
         {
-        case EVENT_TICK:
-            handle_tick();
+        case COM_RX_STATUS_WAIT:
+            // No action required
+            break;
+
+        case COM_RX_STATUS_OK:
+            // Valid command!
+            process_command( input );
             break;
 
-        case EVENT_COM_RX:
-            handle_com_rx();
+        case COM_RX_STATUS_OVERFLOW:
+            // RX buffer overflow!
+            com_tx( "invalid command\r\n" );
             break;
 
         default:
+            // ...??
             assert( false );
             break;
         }
     }
+    while( status != COM_RX_STATUS_WAIT );
 
-} /* main() */
+} /* handle_com_rx() */
 
 
-static void handle_com_rx( void )
+static void handle_idle( event_t event )
 {
-    // Read status from com module
-    static char input[ INPUT_BUF_SIZE ];
-    com_rx_status_t status = com_rx( input, INPUT_BUF_SIZE );
-    switch( status )
-    {
-    case COM_RX_STATUS_WAIT:
-        // No action required
-        break;
+    // Make sure we wake up in time for the next timer (in case one was just started)
+    uint32_t tick;
+    if( swtimer_get_next_expiry( & tick ) )
+        event_schedule_tick( tick );
 
-    case COM_RX_STATUS_OK:
-        // Valid command!
-        process_command( input );
-        break;
+} /* handle_idle() */
 
-    case COM_RX_STATUS_OVERFLOW:
-        // RX buffer overflow!
-        com_tx( "invalid command\r\n" );
-        break;
 
-    default:
-        // ...??
-        assert( false );
-        break;
-    }
+static void handle_tick( event_t event )
+{
+    swtimer_advance( event_tick() );
 
-} /* handle_com_rx() */
+} /* handle_tick() */
 
 
-static void handle_tick( void )
+static void handle_timeout( swtimer_t* timer, void* arg )
 {
-    // Turn off the powerbar if the timeout has expired
-    if( s_timeout && powerbar_get_enabled() && powerbar_get_uptime() > TIMEOUT_MS )
-        powerbar_set_enabled( false );
+    powerbar_set_enabled( false );
 
-} /* handle_tick() */
+} /* handle_timeout() */
 
 
 static void process_command( char const* cmd )
@@ -145,12 +180,14 @@ static void process_command( char const* cmd )
     {
         // Turn the power on
         powerbar_set_enabled( true );
+        update_timeout();
         send_power_state();
     }
     else if( ! strcmp( cmd, "power off" ) )
     {
         // Turn the power off
         powerbar_set_enabled( false );
+        update_timeout();
         send_power_state();
     }
     else if( ! strcmp( cmd, "timeout" ) )
@@ -160,11 +197,13 @@ static void process_command( char const* cmd )
     else if( ! strcmp( cmd, "timeout on" ) )
     {
         s_timeout = true;
+        update_timeout();
         send_timeout_state();
     }
     else if( ! strcmp( cmd, "timeout off" ) )
     {
         s_timeout = false;
+        update_timeout();
         send_timeout_state();
     }
     else
@@ -178,3 +217,21 @@ static void process_command( char const* cmd )
     #undef send_timeout_state
 
 } /* process_command() */
+
+
+static void update_timeout( void )
+{
+    if( ! s_timeout || ! powerbar_get_enabled() )
+    {
+        swtimer_stop( & s_timeout_timer );
+        return;
+    }
+
+    // The timeout expires on the first tick where the uptime exceeds TIMEOUT_MS - the wheel is brought up to date
+    // first, since the delay is measured from the last tick it serviced
+    swtimer_advance( event_tick() );
+    uint32_t uptime = powerbar_get_uptime();
+    uint32_t remaining = ( uptime < TIMEOUT_MS ? TIMEOUT_MS - uptime : 0 );
+    swtimer_start( & s_timeout_timer, remaining + 1, 0, handle_timeout, NULL );
+
+} /* update_timeout() */
@@ -10,9 +10,9 @@
 
 #include <stdint.h>
 
+#include "event/event.h"
 #include "gpio/gpio.h"
 
-#include "event.h"
 #include "powerbar.h"
 
 /* -- Constants -- */
@@ -29,7 +29,7 @@ static uint32_t s_on_tick = 0;
 
 bool powerbar_get_enabled( void )
 {
-    return( gpio_get_state( CTRL_PIN ) == GPIO_STATE_HIGH );
+    return( gpio_fast_get_state( CTRL_PIN ) == GPIO_STATE_HIGH );
 
 } /* powerbar_set_enabled() */
 
@@ -60,8 +60,8 @@ void powerbar_init( void )
 void powerbar_set_enabled( bool enabled )
 {
     gpio_state_t state = ( enabled ? GPIO_STATE_HIGH : GPIO_STATE_LOW );
-    gpio_set_state( LED_PIN, state );
-    gpio_set_state( CTRL_PIN, state );
+    gpio_fast_set_state( LED_PIN, state );
+    gpio_fast_set_state( CTRL_PIN, state );
 
     if( enabled )
         s_on_tick = event_tick();
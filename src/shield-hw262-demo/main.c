@@ -10,9 +10,67 @@
 
 #include <stdbool.h>
 
-#include <util/delay.h>
+#include <avr/pgmspace.h>
 
+#include "event/event.h"
+#include "gpio/gpio-int.h"
 #include "shield/hw262/shield-hw262.h"
+#include "zero/utility.h"
+
+/* -- Types -- */
+
+/**
+ * @brief   Enumeration of the application-defined events.
+ */
+enum
+{
+    EVENT_BUTTON = EVENT_USER,      /**< A button was pressed while asleep.             */
+};
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      any_button_active( void )
+ * @brief   Returns `true` if any button is currently pressed, or has not yet been debounced as released.
+ */
+static bool any_button_active( void );
+
+/**
+ * @fn      handle_button_int( gpio_pin_t, gpio_state_t )
+ * @brief   Posts `EVENT_BUTTON` when a button is pressed.
+ */
+static void handle_button_int( gpio_pin_t pin, gpio_state_t state );
+
+/**
+ * @fn      handle_idle( event_t )
+ * @brief   Decides whether the tick must keep running once every pending event has been handled.
+ */
+static void handle_idle( event_t event );
+
+/**
+ * @fn      handle_tick( event_t )
+ * @brief   Advances button debouncing, and updates the LEDs from the button presses.
+ */
+static void handle_tick( event_t event );
+
+/* -- Variables -- */
+
+static hw262_led_t s_active_led = HW262_LED_D1;
+static bool s_inverted = false;
+
+// Set if every button has a pin change or external interrupt
+static bool s_int_en = true;
+
+// Set while EVENT_SLEEP_TIMER is held (it is acquired by event_init() in periodic mode)
+static bool s_tick_held = true;
+
+// Event handlers
+// (EVENT_BUTTON needs no handler - it only wakes the processor, and the idle handler then keeps it awake)
+static event_handler_t const s_handlers[] PROGMEM =
+{
+    [ EVENT_NONE ]      = handle_idle,
+    [ EVENT_TICK ]      = handle_tick,
+};
 
 /* -- Procedures -- */
 
@@ -20,20 +78,66 @@ int main( void )
 {
     hw262_init();
 
-    hw262_led_t active_led = HW262_LED_D1;
-    while( true )
-    {
-        if( hw262_button_get( HW262_BUTTON_S1 ) )
-            active_led = ( active_led == 0 ? HW262_LED_COUNT - 1 : active_led - 1 );
-        if( hw262_button_get( HW262_BUTTON_S3 ) )
-            active_led = ( active_led == HW262_LED_COUNT - 1 ? 0 : active_led + 1 );
-        if( hw262_button_get( HW262_BUTTON_S2 ) )
-            active_led = 0;
-
-        for( hw262_led_t led = 0; led < HW262_LED_COUNT; led++ )
-            hw262_led_set( led, led == active_led );
+    for( hw262_button_t button = 0; button < HW262_BUTTON_COUNT; button++ )
+        s_int_en &= gpio_int_register( hw262_button_pin( button ), GPIO_EDGE_FALLING, handle_button_int );
 
-        _delay_ms( 50 );
-    }
+    // Buttons are debounced on each 1 ms tick
+    event_init( EVENT_MODE_PERIODIC );
+    event_run( s_handlers, array_count( s_handlers ) );
 
 } /* main() */
+
+
+static bool any_button_active( void )
+{
+    for( hw262_button_t button = 0; button < HW262_BUTTON_COUNT; button++ )
+        if( hw262_button_get( button ) || hw262_button_is_pressed( button ) )
+            return( true );
+
+    return( false );
+
+} /* any_button_active() */
+
+
+static void handle_button_int( gpio_pin_t pin, gpio_state_t state )
+{
+    event_set_pending( EVENT_BUTTON );
+
+} /* handle_button_int() */
+
+
+static void handle_idle( event_t event )
+{
+    // Releasing the tick lets the event manager use power-down mode, so it is only released once the buttons are idle -
+    // pin change interrupts are asynchronous, so a button press still wakes the processor (unless this device has no
+    // interrupts for the button pins, in which case the tick must keep running)
+    bool tick_needed = ! s_int_en || any_button_active();
+    if( tick_needed == s_tick_held )
+        return;
+
+    if( tick_needed )
+        event_sleep_acquire( EVENT_SLEEP_TIMER );
+    else
+        event_sleep_release( EVENT_SLEEP_TIMER );
+    s_tick_held = tick_needed;
+
+} /* handle_idle() */
+
+
+static void handle_tick( event_t event )
+{
+    hw262_update();
+
+    if( hw262_button_take_pressed( HW262_BUTTON_S1 ) )
+        s_active_led = ( s_active_led == 0 ? HW262_LED_COUNT - 1 : s_active_led - 1 );
+    if( hw262_button_take_pressed( HW262_BUTTON_S3 ) )
+        s_active_led = ( s_active_led == HW262_LED_COUNT - 1 ? 0 : s_active_led + 1 );
+    if( hw262_button_take_pressed( HW262_BUTTON_S2 ) )
+        s_active_led = 0;
+    if( hw262_button_take_long_pressed( HW262_BUTTON_S2 ) )
+        s_inverted = ! s_inverted;
+
+    for( hw262_led_t led = 0; led < HW262_LED_COUNT; led++ )
+        hw262_led_set( led, ( led == s_active_led ) != s_inverted );
+
+} /* handle_tick() */
@@ -8,8 +8,32 @@
 
 /* -- Includes -- */
 
+#include <avr/pgmspace.h>
+
+#include "event/event.h"
 #include "lcdtext/lcdtext.h"
+#include "lcdtext/lcdtext-fb.h"
 #include "shield/lcd1602a/shield-lcd1602a.h"
+#include "zero/utility.h"
+
+/* -- Procedure Prototypes -- */
+
+/**
+ * @fn      handle_tick( event_t )
+ * @brief   Advances button debouncing, and displays the pressed button whenever it changes.
+ */
+static void handle_tick( event_t event );
+
+/* -- Variables -- */
+
+// Framebuffer for the shield's LCD
+static lcdtext_fb_t s_fb;
+
+// Event handlers
+static event_handler_t const s_handlers[] PROGMEM =
+{
+    [ EVENT_TICK ]      = handle_tick,
+};
 
 /* -- Procedures -- */
 
@@ -17,34 +41,57 @@ int main( void )
 {
     // Get LCD and initialize
     shield_lcd1602a_init();
-    lcdtext_t const * lcd = shield_lcd1602a_lcd();
+    lcdtext_fb_init( & s_fb, shield_lcd1602a_lcd(), LCDTEXT_1602_LINE_LENGTH, 2 );
+    lcdtext_fb_write_line( & s_fb, 0, "None" );
+    lcdtext_fb_flush( & s_fb );
+
+    // Buttons are debounced on each 1 ms tick
+    event_init( EVENT_MODE_PERIODIC );
+    event_run( s_handlers, array_count( s_handlers ) );
 
-    while( true )
+} /* main() */
+
+
+static void handle_tick( event_t event )
+{
+    static shield_lcd1602a_button_t s_displayed = SHIELD_LCD1602A_BUTTON_NONE;
+
+    shield_lcd1602a_update();
+
+    // Only one button can be pressed at a time through the resistor ladder
+    shield_lcd1602a_button_t button = SHIELD_LCD1602A_BUTTON_NONE;
+    for( shield_lcd1602a_button_t idx = 0; idx < SHIELD_LCD1602A_BUTTON_COUNT; idx++ )
+        if( shield_lcd1602a_button_is_pressed( idx ) )
+            button = idx;
+
+    if( button == s_displayed )
+        return;
+    s_displayed = button;
+
+    // Only the characters which differ from the previous name are sent
+    char const * name;
+    switch( button )
     {
-        lcdtext_go_line_1( lcd );
-        shield_lcd1602a_button_t button = shield_lcd1602a_get_button();
-        switch( button )
-        {
-        case SHIELD_LCD1602A_BUTTON_SELECT:
-            lcdtext_write( lcd, "Select          " );
-            break;
-        case SHIELD_LCD1602A_BUTTON_UP:
-            lcdtext_write( lcd, "Up              " );
-            break;
-        case SHIELD_LCD1602A_BUTTON_DOWN:
-            lcdtext_write( lcd, "Down            " );
-            break;
-        case SHIELD_LCD1602A_BUTTON_LEFT:
-            lcdtext_write( lcd, "Left            " );
-            break;
-        case SHIELD_LCD1602A_BUTTON_RIGHT:
-            lcdtext_write( lcd, "Right           " );
-            break;
-        default:
-            lcdtext_write( lcd, "None            " );
-            break;
-        }
+    case SHIELD_LCD1602A_BUTTON_SELECT:
+        name = "Select";
+        break;
+    case SHIELD_LCD1602A_BUTTON_UP:
+        name = "Up";
+        break;
+    case SHIELD_LCD1602A_BUTTON_DOWN:
+        name = "Down";
+        break;
+    case SHIELD_LCD1602A_BUTTON_LEFT:
+        name = "Left";
+        break;
+    case SHIELD_LCD1602A_BUTTON_RIGHT:
+        name = "Right";
+        break;
+    default:
+        name = "None";
+        break;
     }
+    lcdtext_fb_write_line( & s_fb, 0, name );
+    lcdtext_fb_flush( & s_fb );
 
-
-} /* main() */
+} /* handle_tick() */